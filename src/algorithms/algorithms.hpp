@@ -17,6 +17,20 @@
 #include "common.hpp"
 
 
+// Iterator core of two_way_merge: writes the merge of [a_left, a_right) and [b_left, b_right)
+// to k_iter and returns the end of the written range. No allocation.
+template <typename InputIt1, typename InputIt2, typename OutputIt>
+OutputIt two_way_merge_into(InputIt1 a_left, InputIt1 a_right, InputIt2 b_left, InputIt2 b_right, OutputIt k_iter) {
+    while (a_left != a_right && b_left != b_right) {
+        *k_iter++ = (*a_left <= *b_left) ? *a_left++ : *b_left++;
+    }
+
+    if (a_left == a_right) {
+        return std::copy(b_left, b_right, k_iter);
+    }
+    return std::copy(a_left, a_right, k_iter);
+}
+
 /*
  * Algorithm: Two-way Merge
  *
@@ -46,21 +60,8 @@
  */
 template <typename IterContainer>
 IterContainer two_way_merge(const IterContainer& a, const IterContainer& b) {
-    auto [a_left, a_right, b_left, b_right] = std::array<typename IterContainer::const_iterator, 4>{{a.begin(), a.end(), b.begin(), b.end()}};
     IterContainer r(a.size() + b.size()); // Resulting vector
-
-    typename IterContainer::iterator k_iter = r.begin(); // Pointer for insertion
-
-    while (a_left != a_right && b_left != b_right) {
-        *k_iter++ = (*a_left <= *b_left) ? *a_left++ : *b_left++;
-    }
-
-    if (a_left == a_right) {
-        std::copy(b_left, b_right, k_iter);
-    } else {
-        std::copy(a_left, a_right, k_iter);
-    }
-
+    two_way_merge_into(a.begin(), a.end(), b.begin(), b.end(), r.begin());
     return r;
 }
 
@@ -84,6 +85,71 @@ void binary_insertion(IterContainer& arr, const T& elem) {
     arr.insert(l, elem);
 }
 
+// Iterator core of hwang_lin_knuth_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (from back to front) and returns the end of the written range.
+template <typename RandomIt, typename OutputIt>
+requires std::random_access_iterator<RandomIt>
+OutputIt hwang_lin_knuth_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
+    using size_t  = std::size_t;
+    using iter    = RandomIt;
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    iter a_left  = a_first, a_right = a_last;
+    iter b_left  = b_first, b_right = b_last;
+    size_t m = static_cast<size_t>(a_last - a_first);
+    size_t n = static_cast<size_t>(b_last - b_first);
+
+    OutputIt out_end = out + (m + n);
+    if (!m) return std::copy(b_first, b_last, out);
+    if (!n) return std::copy(a_first, a_last, out);
+
+    auto k = out_end;
+
+    while (m && n)
+    {
+        // H1
+        if (m > n) {
+            std::swap(a_left,  b_left);
+            std::swap(a_right, b_right);
+            std::swap(m, n);
+        }
+
+        size_t s = bit_floor(n / m);
+
+        // H2 / H4
+        if (*(a_right - 1) < *(b_right - s)) {
+            k = std::copy_backward(b_right - s, b_right, k);
+            b_right -= s;  n -= s;
+            continue; // back to H1
+        }
+
+        // H3 / H5
+        value_t a_last = *(a_right - 1);
+
+        iter pos;
+        if (s <= 8) {
+            pos = b_right;
+            do { --pos; } while (a_last < *pos);
+            ++pos;
+        } else {
+            pos = std::upper_bound(b_right - s, b_right, a_last);
+        }
+
+        size_t tail = static_cast<size_t>(b_right - pos);
+        k = std::copy_backward(pos, b_right, k);
+        *--k = a_last;
+
+        b_right = pos;
+        n -= tail;
+        --a_right; --m;
+    }
+
+    if (m)  std::copy_backward(a_left, a_right, k);
+    else    std::copy_backward(b_left, b_right, k);
+
+    return out_end;
+}
+
 /*
  * Algorithm: Hwang-Lin Merge (Knuth)
  *
@@ -114,20 +180,41 @@ void binary_insertion(IterContainer& arr, const T& elem) {
 template <typename IterContainer>
 requires std::random_access_iterator<typename IterContainer::const_iterator>
 IterContainer hwang_lin_knuth_merge(const IterContainer& a, const IterContainer& b) {
-    using size_t  = typename IterContainer::size_type;
-    using iter    = typename IterContainer::const_iterator;
-    using value_t = typename IterContainer::value_type;
-
-    iter a_left  = a.begin(), a_right = a.end();
-    iter b_left  = b.begin(), b_right = b.end();
-    size_t m = a.size();
-    size_t n = b.size();
+    if (a.empty()) return b;
+    if (b.empty()) return a;
 
-    if (!m) return b;
-    if (!n) return a;
+    IterContainer out(a.size() + b.size());
+    hwang_lin_knuth_merge_into(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+    return out;
+}
 
-    IterContainer out(m + n);
-    auto k = out.end();
+// Stable form of hwang_lin_knuth_merge_into: if a[i] == b[j], a[i] is written first.
+// H1 may swap the roles of the sequences, so `a_first` tracks which of them came first:
+// the element taken from the shorter one goes before equal elements of the longer one
+// only if the shorter one is a.
+template <typename RandomIt, typename OutputIt>
+requires std::random_access_iterator<RandomIt>
+OutputIt hwang_lin_knuth_stable_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
+    using size_t  = std::size_t;
+    using iter    = RandomIt;
+    using value_t = typename std::iterator_traits<RandomIt>::value_type;
+
+    iter a_left  = a_first, a_right = a_last;
+    iter b_left  = b_first, b_right = b_last;
+    size_t m = static_cast<size_t>(a_last - a_first);
+    size_t n = static_cast<size_t>(b_last - b_first);
+    bool short_is_a = true;
+
+    OutputIt out_end = out + (m + n);
+    if (!m) return std::copy(b_first, b_last, out);
+    if (!n) return std::copy(a_first, a_last, out);
+
+    // Whether y (longer sequence) is written after x (shorter sequence).
+    auto after = [&short_is_a](const value_t& x, const value_t& y) {
+        return short_is_a ? x <= y : x < y;
+    };
+
+    auto k = out_end;
 
     while (m && n)
     {
@@ -136,94 +223,72 @@ IterContainer hwang_lin_knuth_merge(const IterContainer& a, const IterContainer&
             std::swap(a_left,  b_left);
             std::swap(a_right, b_right);
             std::swap(m, n);
+            short_is_a = !short_is_a;
         }
 
         size_t s = bit_floor(n / m);
 
         // H2 / H4
-        if (*(a_right - 1) < *(b_right - s)) {
-            k -= s;
-            std::copy(b_right - s, b_right, k);
+        if (after(*(a_right - 1), *(b_right - s))) {
+            k = std::copy_backward(b_right - s, b_right, k);
             b_right -= s;  n -= s;
             continue; // back to H1
         }
 
         // H3 / H5
-        value_t a_last = *(a_right - 1);
+        value_t x = *(a_right - 1);
 
         iter pos;
         if (s <= 8) {
             pos = b_right;
-            do { --pos; } while (a_last < *pos);
+            do { --pos; } while (after(x, *pos));
             ++pos;
+        } else if (short_is_a) {
+            pos = std::lower_bound(b_right - s, b_right, x);
         } else {
-            pos = std::upper_bound(b_right - s, b_right, a_last);
+            pos = std::upper_bound(b_right - s, b_right, x);
         }
 
         size_t tail = static_cast<size_t>(b_right - pos);
-        k -= tail + 1;
-        std::copy(pos, b_right, k + 1);
-        *k = a_last;
+        k = std::copy_backward(pos, b_right, k);
+        *--k = x;
 
         b_right = pos;
         n -= tail;
         --a_right; --m;
     }
 
-    if (m)  std::copy(a_left, a_right, k - m);
-    else    std::copy(b_left, b_right, k - n);
+    if (m)  std::copy_backward(a_left, a_right, k);
+    else    std::copy_backward(b_left, b_right, k);
 
-    return out;
+    return out_end;
 }
 
-/*
- * Algorithm: Hwang-Lin Static Merge
- *
- * Publication:
- *   Thanh M., The Design and Analysis of Algorithms For Sort and Merge using Compressions
- *   // Master's Thesis. – Concordia University, Montreal, Canada. – 1983. – c.39-43.
- *
- * Implementation:
- *   Developer: Sergei Gorlov
- *
- * Parameters:
- *   IterContainer& a - container with a sorted sequence of smaller size.
- *                      Elements must be in ascending order.
- *                      IMPORTANT: The container must be accessed starting from its beginning.
- *
- *   IterContainer& b - container with a sorted sequence of larger size.
- *                      Elements must be in ascending order.
- *                      IMPORTANT: The container must be accessed starting from its beginning.
- *
- * Return Value:
- *   IterContainer - merged container containing all elements from a and b, sorted in ascending order.
- *
- * Notes:
- *   - Containers must support the methods size(), reserve(), begin(), end(), insert().
- *   - It is assumed that the containers a and b are already sorted before calling the function.
- *
- */
-template <typename IterContainer>
-IterContainer hwang_lin_static_merge(IterContainer& a, IterContainer& b) {
-    if (a.empty()) {
-        return b;
+// Iterator core of hwang_lin_static_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (from back to front) and returns the end of the written range.
+// Performs the same comparisons as hwang_lin_static_merge, without allocating.
+template <typename RandomIt, typename OutputIt>
+OutputIt hwang_lin_static_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
+    int m = static_cast<int>(std::distance(a_first, a_last));
+    int n = static_cast<int>(std::distance(b_first, b_last));
+    OutputIt out_end = out + (m + n);
+
+    if (m == 0) {
+        std::copy(b_first, b_last, out);
+        return out_end;
     }
-    if (b.empty()) {
-        return a;
+    if (n == 0) {
+        std::copy(a_first, a_last, out);
+        return out_end;
     }
 
     // Swap a and b if a is larger than b.
-    if (a.size() > b.size()) {
-        std::swap(a, b);
+    if (m > n) {
+        std::swap(a_first, b_first);
+        std::swap(m, n);
     }
 
-    int m = static_cast<int>(a.size());
-    int n = static_cast<int>(b.size());
-
-    // Pre-allocate result to avoid reallocations during merge.
-    IterContainer results(a.size() + b.size());
-    
-    typename IterContainer::iterator r_iter = results.end(); // write-pointer starting from the back.
+    OutputIt r_iter = out_end; // write-pointer starting from the back.
 
     int t = static_cast<int>(std::floor(std::log2(static_cast<double>(n) / m)));
     int pow2t = pow2(t);
@@ -238,66 +303,59 @@ IterContainer hwang_lin_static_merge(IterContainer& a, IterContainer& b) {
         if (k < 0) k = 0;
 
         // Case 1: entire block from b is greater than lastA.
-        if (a[m - 1] < b[k]) {
+        if (a_first[m - 1] < b_first[k]) {
             // Copy the block [k, n) from b into the result
-            r_iter -= pow2t;
-            std::copy(b.begin() + k, b.begin() + n, r_iter);
+            r_iter = std::copy_backward(b_first + k, b_first + n, r_iter);
             n -= pow2t;
             continue;
         } else {
             // Case 2: need to insert lastA into the correct position within the block
             auto pos = std::upper_bound(
-                b.begin() + k + 1, 
-                b.begin() + n, 
-                a[m - 1]
+                b_first + k + 1, 
+                b_first + n, 
+                a_first[m - 1]
             );
 
             // Copy the tail of b from pos to n
-            r_iter -= static_cast<int>(std::distance(pos, b.begin() + n));
-            std::copy(pos, b.begin() + n, r_iter);
+            r_iter = std::copy_backward(pos, b_first + n, r_iter);
             
             // Insert lastA right before the copied tail
             --r_iter;
-            *r_iter = a[m - 1];   
+            *r_iter = a_first[m - 1];   
 
-            n = static_cast<int>(std::distance(b.begin(), pos));
+            n = static_cast<int>(std::distance(b_first, pos));
             m--;
         }
     }
 
     // Final merge for remaining elements in a and b, writing from back to front.
-    auto a_it = a.begin() + m;
-    auto b_it = b.begin() + n;
+    auto a_it = a_first + m;
+    auto b_it = b_first + n;
 
     // Merge tail segments in reverse order.
-    while (a_it != a.begin() && b_it != b.begin()) {
+    while (a_it != a_first && b_it != b_first) {
         *--r_iter = (*std::prev(a_it) >= *std::prev(b_it))
             ? *--a_it
             : *--b_it;
     }
 
     // Copy any leftovers from a or b
-    while (a_it != a.begin()) {
+    while (a_it != a_first) {
         *--r_iter = *--a_it;
     }
-    while (b_it != b.begin()) {
+    while (b_it != b_first) {
         *--r_iter = *--b_it;
     }
 
-    return results;
+    return out_end;
 }
 
-
 /*
- * Algorithm: Hwang–Lin Static Stable Merge
+ * Algorithm: Hwang-Lin Static Merge
  *
- * Origin:
- *   Based on:
- *     Thanh M., The Design and Analysis of Algorithms For Sort and Merge using Compressions
- *     // Master's Thesis. – Concordia University, Montreal, Canada. – 1983. – pp.39–43.
- *   Enhancements:
- *     This implementation extends the original static merge to guarantee stability—
- *     i.e. when a[i] == b[j], elements from `a` always precede those from `b`.
+ * Publication:
+ *   Thanh M., The Design and Analysis of Algorithms For Sort and Merge using Compressions
+ *   // Master's Thesis. – Concordia University, Montreal, Canada. – 1983. – c.39-43.
  *
  * Implementation:
  *   Developer: Sergei Gorlov
@@ -311,38 +369,53 @@ IterContainer hwang_lin_static_merge(IterContainer& a, IterContainer& b) {
  *                      Elements must be in ascending order.
  *                      IMPORTANT: The container must be accessed starting from its beginning.
  *
- * Returns:
- *   IterContainer – new container of size a.size()+b.size(), sorted ascending,
- *                    with stable ordering: if a[i] == b[j], all from `a` come first.
+ * Return Value:
+ *   IterContainer - merged container containing all elements from a and b, sorted in ascending order.
  *
  * Notes:
- *   - Both inputs must be pre-sorted in non-decreasing order.
- *   - Stability is guaranteed even when input sizes vary.
- *   - The result is written from back to front to avoid extra memory moves.
+ *   - Containers must support the methods size(), reserve(), begin(), end(), insert().
+ *   - It is assumed that the containers a and b are already sorted before calling the function.
+ *
  */
 template <typename IterContainer>
-IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b) {
-    // Return the other container if one is empty.
+IterContainer hwang_lin_static_merge(IterContainer& a, IterContainer& b) {
     if (a.empty()) {
         return b;
     }
     if (b.empty()) {
         return a;
-    } 
+    }
+
+    // Swap a and b if a is larger than b.
+    if (a.size() > b.size()) {
+        std::swap(a, b);
+    }
+
+    // Pre-allocate result to avoid reallocations during merge.
+    IterContainer results(a.size() + b.size());
+    hwang_lin_static_merge_into(a.begin(), a.end(), b.begin(), b.end(), results.begin());
+    return results;
+}
+
 
+// Iterator core of hwang_lin_static_stable_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (back to front) and returns the end of the written range.
+template <typename RandomIt, typename OutputIt>
+OutputIt hwang_lin_static_stable_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
     // Record sizes of both input ranges.
-    int m = static_cast<int>(a.size());
-    int n = static_cast<int>(b.size());
+    int m = static_cast<int>(std::distance(a_first, a_last));
+    int n = static_cast<int>(std::distance(b_first, b_last));
+
+    if (m == 0) return std::copy(b_first, b_last, out);
+    if (n == 0) return std::copy(a_first, a_last, out);
 
-    // Allocate output of combined size to avoid reallocations.
-    IterContainer result(a.size() + b.size());
-    
     // Initialize write iterator at the end of the output.
-    auto r_iter = result.end();
+    OutputIt out_end = out + (m + n);
+    auto r_iter = out_end;
 
 
     // Choose branch based on which input is larger.
-    if (b.size() >= a.size()) {
+    if (n >= m) {
         // Compute block size parameter t and block length 2^t.
         int t = static_cast<int>(std::floor(std::log2(static_cast<double>(n) / m)));
         int pow2t = pow2(t);
@@ -359,30 +432,27 @@ IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b)
             if (k < 0) k = 0;
 
             // Case 1: block in b is strictly larger than last element of a.
-            if (a[m - 1] <= b[k]) {
+            if (a_first[m - 1] <= b_first[k]) {
                 // Copy entire block from b[k..n) to output.
-                r_iter -= pow2t;
-                std::copy(b.begin() + k, b.begin() + n, r_iter);
+                r_iter = std::copy_backward(b_first + k, b_first + n, r_iter);
                 n -= pow2t;
                 continue;
             } else {
                 // Case 2: insert last element of a into b before first larger element.
                 auto pos = std::lower_bound(
-                    b.begin() + k + 1, 
-                    b.begin() + n, 
-                    a[m - 1]
+                    b_first + k + 1, 
+                    b_first + n, 
+                    a_first[m - 1]
                 );
 
                 // Copy tail of b from pos..n to output.
-                int tailSize = static_cast<int>(std::distance(pos, b.begin() + n));
-                r_iter -= tailSize;
-                std::copy(pos, b.begin() + n, r_iter);
+                r_iter = std::copy_backward(pos, b_first + n, r_iter);
                 
                 // Place a[m-1] immediately before the copied tail.
-                *(--r_iter) = a[m - 1];
+                *(--r_iter) = a_first[m - 1];
 
                 // Update counts for next iteration.
-                n = static_cast<int>(std::distance(b.begin(), pos));
+                n = static_cast<int>(std::distance(b_first, pos));
                 m--;
             }
         }
@@ -403,30 +473,27 @@ IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b)
             if (k < 0) k = 0;
 
             // Case 1: block in a is strictly larger than last element of b.
-            if (b[n - 1] < a[k]) {
+            if (b_first[n - 1] < a_first[k]) {
                 // Copy entire block from a[k..m) to output.
-                r_iter -= pow2t;
-                std::copy(a.begin() + k, a.begin() + m, r_iter);
+                r_iter = std::copy_backward(a_first + k, a_first + m, r_iter);
                 m -= pow2t;
                 continue;
             } else {
                 // Case 2: insert last element of b into a before first larger element.
                 auto pos = std::upper_bound(
-                    a.begin() + k + 1, 
-                    a.begin() + m, 
-                    b[n - 1]
+                    a_first + k + 1, 
+                    a_first + m, 
+                    b_first[n - 1]
                 );
 
                 // Copy tail of a from pos..m to output.
-                int tailSize = static_cast<int>(std::distance(pos, a.begin() + m));
-                r_iter -= tailSize;
-                std::copy(pos, a.begin() + m, r_iter);
+                r_iter = std::copy_backward(pos, a_first + m, r_iter);
                 
                 // Place b[n-1] immediately before the copied tail.
-                *(--r_iter) = b[n - 1];
+                *(--r_iter) = b_first[n - 1];
 
                 // Update counts for next iteration.
-                m = static_cast<int>(std::distance(a.begin(), pos));
+                m = static_cast<int>(std::distance(a_first, pos));
                 n--;
             }
         }
@@ -434,35 +501,39 @@ IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b)
 
 
     // Perform final reverse merge of remaining elements.
-    auto a_it = a.begin() + m;
-    auto b_it = b.begin() + n;
+    auto a_it = a_first + m;
+    auto b_it = b_first + n;
 
     // Merge tail segments in reverse order.
-    while (a_it != a.begin() && b_it != b.begin()) {
+    while (a_it != a_first && b_it != b_first) {
         *--r_iter = (*std::prev(a_it) > *std::prev(b_it))
             ? *--a_it
             : *--b_it;
     }
 
     // Copy any leftovers from b.
-    while (b_it != b.begin()) {
+    while (b_it != b_first) {
         *--r_iter = *--b_it;
     }
     // Copy any leftovers from a.
-    while (a_it != a.begin()) {
+    while (a_it != a_first) {
         *--r_iter = *--a_it;
     }
 
-    return result;
+    return out_end;
 }
 
 
 /*
- * Algorithm: Hwang-Lin Dynamic Merge
+ * Algorithm: Hwang–Lin Static Stable Merge
  *
- * Publication:
- *   Thanh M. and Bui T. D., An Improvement of The Binary Merge Algorithm
- *   // Concordia University, Montreal, Canada. – 1982. – с.455-462
+ * Origin:
+ *   Based on:
+ *     Thanh M., The Design and Analysis of Algorithms For Sort and Merge using Compressions
+ *     // Master's Thesis. – Concordia University, Montreal, Canada. – 1983. – pp.39–43.
+ *   Enhancements:
+ *     This implementation extends the original static merge to guarantee stability—
+ *     i.e. when a[i] == b[j], elements from `a` always precede those from `b`.
  *
  * Implementation:
  *   Developer: Sergei Gorlov
@@ -476,16 +547,17 @@ IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b)
  *                      Elements must be in ascending order.
  *                      IMPORTANT: The container must be accessed starting from its beginning.
  *
- * Return Value:
- *   IterContainer - merged container containing all elements from a and b, sorted in ascending order.
+ * Returns:
+ *   IterContainer – new container of size a.size()+b.size(), sorted ascending,
+ *                    with stable ordering: if a[i] == b[j], all from `a` come first.
  *
  * Notes:
- *   - Containers must support the methods size(), reserve(), begin(), end(), insert().
- *   - It is assumed that the containers a and b are already sorted before calling the function.
- *
+ *   - Both inputs must be pre-sorted in non-decreasing order.
+ *   - Stability is guaranteed even when input sizes vary.
+ *   - The result is written from back to front to avoid extra memory moves.
  */
 template <typename IterContainer>
-IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
+IterContainer hwang_lin_static_stable_merge(IterContainer& a, IterContainer& b) {
     // Return the other container if one is empty.
     if (a.empty()) {
         return b;
@@ -493,25 +565,37 @@ IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
     if (b.empty()) {
         return a;
     }
-    
-    // Swap a and b if a is larger than b to ensure a is the smaller sequence.
-    if (a.size() > b.size()) {
-        std::swap(a, b);
-    }
 
+    // Pre-allocate result to avoid reallocations during merge.
+    IterContainer results(a.size() + b.size());
+    hwang_lin_static_stable_merge_into(a.begin(), a.end(), b.begin(), b.end(), results.begin());
+    return results;
+}
+
+
+// Iterator core of hwang_lin_dynamic_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (front to back) and returns the end of the written range.
+template <typename RandomIt, typename OutputIt>
+OutputIt hwang_lin_dynamic_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
     // Record sizes of both input ranges.
-    int m = static_cast<int>(a.size());
-    int n = static_cast<int>(b.size());
+    int m = static_cast<int>(std::distance(a_first, a_last));
+    int n = static_cast<int>(std::distance(b_first, b_last));
+
+    // Swap a and b if a is larger than b to ensure a is the smaller sequence.
+    if (m > n) {
+        std::swap(a_first, b_first);
+        std::swap(a_last, b_last);
+        std::swap(m, n);
+    }
+    if (m == 0) return std::copy(b_first, b_last, out);
+    if (n == 0) return std::copy(a_first, a_last, out);
 
     // Initialize indices for both sequences.
     size_t i = 0; // index into A
     size_t j = 0; // index into B
 
-    // Pre-allocate result to avoid reallocations during merge.
-    IterContainer results(a.size() + b.size());
-    
     // Initialize write iterator at the beginning of the output.
-    typename IterContainer::iterator r_iter = results.begin();
+    OutputIt r_iter = out;
 
     int remainingA = m - i;
     int remainingB = n - j;
@@ -547,65 +631,65 @@ IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
         int c4 = ((41 * pow2d) / 28) - 1;  // Block size for Node D
 
         // Get next 4 elements from sequence a.
-        auto a1 = a[i];
-        auto a2 = a[i + 1];
-        auto a3 = a[i + 2];
-        auto a4 = a[i + 3];
+        auto a1 = a_first[i];
+        auto a2 = a_first[i + 1];
+        auto a3 = a_first[i + 2];
+        auto a4 = a_first[i + 3];
 
         // NODE A: Handle case where first element of a is greater than entire block in b.
-        if ((j + c1 - 1) < n && a1 > b[j + c1 - 1]) {
-            std::copy(b.begin() + j, b.begin() + j + c1, r_iter);
+        if ((j + c1 - 1) < n && a1 > b_first[j + c1 - 1]) {
+            std::copy(b_first + j, b_first + j + c1, r_iter);
             r_iter += c1;
             j += c1;
             continue;
         }
 
         // NODE B: Handle case where second element of a is greater than block in b.
-        if ((j + c2 - 1) < n && a2 > b[j + c2 - 1]) {
-            auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c1, r_iter, a1);
-            std::copy(pos1, b.begin() + j + c2, r_iter);
-            r_iter += std::distance(pos1, b.begin() + j + c2);
+        if ((j + c2 - 1) < n && a2 > b_first[j + c2 - 1]) {
+            auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c1, r_iter, a1);
+            std::copy(pos1, b_first + j + c2, r_iter);
+            r_iter += std::distance(pos1, b_first + j + c2);
             i++;
             j += c2;
             continue;
         }
 
         // NODE C: Handle case where third element of a is greater than block in b.
-        if ((j + c3 - 1) < n && a3 > b[j + c3 - 1]) {
-            auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c2, r_iter, a1);
-            auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c2 + 1, r_iter, a2);
-            std::copy(pos2, b.begin() + j + c3, r_iter);
-            r_iter += std::distance(pos2, b.begin() + j + c3);
+        if ((j + c3 - 1) < n && a3 > b_first[j + c3 - 1]) {
+            auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c2, r_iter, a1);
+            auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c2 + 1, r_iter, a2);
+            std::copy(pos2, b_first + j + c3, r_iter);
+            r_iter += std::distance(pos2, b_first + j + c3);
             i += 2;
             j += c3;
             continue;
         }
 
         // NODE D: Handle case where fourth element of a is greater than block in b.
-        if ((j + c4 - 1) < n && a4 > b[j + c4 - 1]) {            
-            auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c3, r_iter, a1);
-            auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c3, r_iter, a2);
-            auto pos3 = insert_and_copy_lower_bound<IterContainer>(pos2, b.begin() + j + c3, r_iter, a3);
+        if ((j + c4 - 1) < n && a4 > b_first[j + c4 - 1]) {            
+            auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c3, r_iter, a1);
+            auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c3, r_iter, a2);
+            auto pos3 = insert_and_copy_lower_bound(pos2, b_first + j + c3, r_iter, a3);
             i += 3;
-            j += std::distance(b.begin() + j, pos3);
+            j += std::distance(b_first + j, pos3);
             continue;
         }
 
         // NODE E: Handle remaining case by inserting all four elements from a into b.
-        auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c4, r_iter, a1);
-        auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c4 + 1, r_iter, a2);
-        auto pos3 = insert_and_copy_lower_bound<IterContainer>(pos2, b.begin() + j + c4 + 2, r_iter, a3);
-        auto pos4 = insert_and_copy_lower_bound<IterContainer>(pos3, b.begin() + j + c4 + 3, r_iter, a4);
+        auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c4, r_iter, a1);
+        auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c4 + 1, r_iter, a2);
+        auto pos3 = insert_and_copy_lower_bound(pos2, b_first + j + c4 + 2, r_iter, a3);
+        auto pos4 = insert_and_copy_lower_bound(pos3, b_first + j + c4 + 3, r_iter, a4);
         i += 4;
-        j += std::distance(b.begin() + j, pos4);
+        j += std::distance(b_first + j, pos4);
     }
 
     // Merge remaining elements from both sequences.
-    auto a_it = a.begin() + i;
-    auto b_it = b.begin() + j;
+    auto a_it = a_first + i;
+    auto b_it = b_first + j;
 
     // Merge remaining elements from both arrays.
-    while (a_it != a.end() && b_it != b.end()) {
+    while (a_it != a_last && b_it != b_last) {
         if (*a_it <= *b_it) {
             *r_iter++ = *a_it++;
         } else {
@@ -614,30 +698,25 @@ IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
     }
 
     // Copy any remaining elements from a.
-    while (a_it != a.end()) {
+    while (a_it != a_last) {
         *r_iter++ = *a_it++;
     }
 
     // Copy any remaining elements from b.
-    while (b_it != b.end()) {
+    while (b_it != b_last) {
         *r_iter++ = *b_it++;
     }
 
-    return results;
+    return r_iter;
 }
 
 
 /*
- * Algorithm: Hwang-Lin Dynamic Stable Merge
- *
- * Origin:
- *   Based on:
- *     Thanh M. and Bui T. D., An Improvement of The Binary Merge Algorithm
- *     // Concordia University, Montreal, Canada. – 1982. – с.455-462
- *   Enhancements:
- *     This implementation extends the original dynamic merge to guarantee stability—
- *     i.e. when a[i] == b[j], elements from `a` always precede those from `b`.
+ * Algorithm: Hwang-Lin Dynamic Merge
  *
+ * Publication:
+ *   Thanh M. and Bui T. D., An Improvement of The Binary Merge Algorithm
+ *   // Concordia University, Montreal, Canada. – 1982. – с.455-462
  *
  * Implementation:
  *   Developer: Sergei Gorlov
@@ -651,9 +730,8 @@ IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
  *                      Elements must be in ascending order.
  *                      IMPORTANT: The container must be accessed starting from its beginning.
  *
- * Returns:
- *   IterContainer – new container of size a.size()+b.size(), sorted ascending,
- *                    with stable ordering: if a[i] == b[j], all from `a` come first.
+ * Return Value:
+ *   IterContainer - merged container containing all elements from a and b, sorted in ascending order.
  *
  * Notes:
  *   - Containers must support the methods size(), reserve(), begin(), end(), insert().
@@ -661,7 +739,7 @@ IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
  *
  */
 template <typename IterContainer>
-IterContainer hwang_lin_dynamic_stable_merge(IterContainer& a, IterContainer& b) {
+IterContainer hwang_lin_dynamic_merge(IterContainer& a, IterContainer& b) {
     // Return the other container if one is empty.
     if (a.empty()) {
         return b;
@@ -669,25 +747,41 @@ IterContainer hwang_lin_dynamic_stable_merge(IterContainer& a, IterContainer& b)
     if (b.empty()) {
         return a;
     }
+    
+    // Swap a and b if a is larger than b to ensure a is the smaller sequence.
+    if (a.size() > b.size()) {
+        std::swap(a, b);
+    }
 
+    // Pre-allocate result to avoid reallocations during merge.
+    IterContainer results(a.size() + b.size());
+    hwang_lin_dynamic_merge_into(a.begin(), a.end(), b.begin(), b.end(), results.begin());
+    return results;
+}
+
+
+// Iterator core of hwang_lin_dynamic_stable_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (front to back) and returns the end of the written range.
+template <typename RandomIt, typename OutputIt>
+OutputIt hwang_lin_dynamic_stable_merge_into(RandomIt a_first, RandomIt a_last, RandomIt b_first, RandomIt b_last, OutputIt out) {
     // Record sizes of both input ranges.
-    int m = static_cast<int>(a.size());
-    int n = static_cast<int>(b.size());
+    int m = static_cast<int>(std::distance(a_first, a_last));
+    int n = static_cast<int>(std::distance(b_first, b_last));
 
     // Initialize indices for both sequences.
     size_t i = 0; // index into A
     size_t j = 0; // index into B
 
-    // Pre-allocate result to avoid reallocations during merge.
-    IterContainer results(a.size() + b.size());
-    
+    if (m == 0) return std::copy(b_first, b_last, out);
+    if (n == 0) return std::copy(a_first, a_last, out);
+
     // Initialize write iterator at the beginning of the output.
-    typename IterContainer::iterator r_iter = results.begin();
+    OutputIt r_iter = out;
 
     int remainingA = m - i;
     int remainingB = n - j;
 
-    if (b.size() >= a.size()) {
+    if (n >= m) {
         while (remainingA > 0) {
             remainingA = m - i;
             remainingB = n - j;
@@ -714,57 +808,57 @@ IterContainer hwang_lin_dynamic_stable_merge(IterContainer& a, IterContainer& b)
             int c4 = ((41 * pow2d) / 28) - 1;  // Block size for Node D
 
             // Get next 4 elements from sequence a.
-            auto a1 = a[i];
-            auto a2 = a[i + 1];
-            auto a3 = a[i + 2];
-            auto a4 = a[i + 3];
+            auto a1 = a_first[i];
+            auto a2 = a_first[i + 1];
+            auto a3 = a_first[i + 2];
+            auto a4 = a_first[i + 3];
 
             // NODE A: Handle case where first element of a is greater than entire block in b.
-            if ((j + c1 - 1) < n && a1 > b[j + c1 - 1]) {
-                std::copy(b.begin() + j, b.begin() + j + c1, r_iter);
+            if ((j + c1 - 1) < n && a1 > b_first[j + c1 - 1]) {
+                std::copy(b_first + j, b_first + j + c1, r_iter);
                 r_iter += c1;
                 j += c1;
                 continue;
             }
 
             // NODE B: Handle case where second element of a is greater than block in b.
-            if ((j + c2 - 1) < n && a2 > b[j + c2 - 1]) {
-                auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c1, r_iter, a1);
-                std::copy(pos1, b.begin() + j + c2, r_iter);
-                r_iter += std::distance(pos1, b.begin() + j + c2);
+            if ((j + c2 - 1) < n && a2 > b_first[j + c2 - 1]) {
+                auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c1, r_iter, a1);
+                std::copy(pos1, b_first + j + c2, r_iter);
+                r_iter += std::distance(pos1, b_first + j + c2);
                 i++;
                 j += c2;
                 continue;
             }
 
             // NODE C: Handle case where third element of a is greater than block in b.
-            if ((j + c3 - 1) < n && a3 > b[j + c3 - 1]) {
-                auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c2, r_iter, a1);
-                auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c2 + 1, r_iter, a2);
-                std::copy(pos2, b.begin() + j + c3, r_iter);
-                r_iter += std::distance(pos2, b.begin() + j + c3);
+            if ((j + c3 - 1) < n && a3 > b_first[j + c3 - 1]) {
+                auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c2, r_iter, a1);
+                auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c2 + 1, r_iter, a2);
+                std::copy(pos2, b_first + j + c3, r_iter);
+                r_iter += std::distance(pos2, b_first + j + c3);
                 i += 2;
                 j += c3;
                 continue;
             }
 
             // NODE D: Handle case where fourth element of a is greater than block in b.
-            if ((j + c4 - 1) < n && a4 > b[j + c4 - 1]) {            
-                auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c3, r_iter, a1);
-                auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c3, r_iter, a2);
-                auto pos3 = insert_and_copy_lower_bound<IterContainer>(pos2, b.begin() + j + c3, r_iter, a3);
+            if ((j + c4 - 1) < n && a4 > b_first[j + c4 - 1]) {            
+                auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c3, r_iter, a1);
+                auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c3, r_iter, a2);
+                auto pos3 = insert_and_copy_lower_bound(pos2, b_first + j + c3, r_iter, a3);
                 i += 3;
-                j += std::distance(b.begin() + j, pos3);
+                j += std::distance(b_first + j, pos3);
                 continue;
             }
 
             // NODE E: Handle remaining case by inserting all four elements from a into b.
-            auto pos1 = insert_and_copy_lower_bound<IterContainer>(b.begin() + j, b.begin() + j + c4, r_iter, a1);
-            auto pos2 = insert_and_copy_lower_bound<IterContainer>(pos1, b.begin() + j + c4 + 1, r_iter, a2);
-            auto pos3 = insert_and_copy_lower_bound<IterContainer>(pos2, b.begin() + j + c4 + 2, r_iter, a3);
-            auto pos4 = insert_and_copy_lower_bound<IterContainer>(pos3, b.begin() + j + c4 + 3, r_iter, a4);
+            auto pos1 = insert_and_copy_lower_bound(b_first + j, b_first + j + c4, r_iter, a1);
+            auto pos2 = insert_and_copy_lower_bound(pos1, b_first + j + c4 + 1, r_iter, a2);
+            auto pos3 = insert_and_copy_lower_bound(pos2, b_first + j + c4 + 2, r_iter, a3);
+            auto pos4 = insert_and_copy_lower_bound(pos3, b_first + j + c4 + 3, r_iter, a4);
             i += 4;
-            j += std::distance(b.begin() + j, pos4);
+            j += std::distance(b_first + j, pos4);
         }
     } else {
         while (remainingB > 0) {
@@ -793,79 +887,129 @@ IterContainer hwang_lin_dynamic_stable_merge(IterContainer& a, IterContainer& b)
             int c4 = ((41 * pow2d) / 28) - 1;  // Block size for Node D
 
             // Get next 4 elements from sequence a.
-            auto b1 = b[j];
-            auto b2 = b[j + 1];
-            auto b3 = b[j + 2];
-            auto b4 = b[j + 3];
+            auto b1 = b_first[j];
+            auto b2 = b_first[j + 1];
+            auto b3 = b_first[j + 2];
+            auto b4 = b_first[j + 3];
 
             // NODE A: Handle case where first element of a is greater than entire block in b.
-            if ((i + c1 - 1) < m && b1 >= a[i + c1 - 1]) {
-                std::copy(a.begin() + i, a.begin() + i + c1, r_iter);
+            if ((i + c1 - 1) < m && b1 >= a_first[i + c1 - 1]) {
+                std::copy(a_first + i, a_first + i + c1, r_iter);
                 r_iter += c1;
                 i += c1;
                 continue;
             }
 
             // NODE B: Handle case where second element of a is greater than block in b.
-            if ((i + c2 - 1) < m && b2 >= a[i + c2 - 1]) {
-                auto pos1 = insert_and_copy_upper_bound<IterContainer>(a.begin() + i, a.begin() + i + c1, r_iter, b1);
-                std::copy(pos1, a.begin() + i + c2, r_iter);
-                r_iter += std::distance(pos1, a.begin() + i + c2);
+            if ((i + c2 - 1) < m && b2 >= a_first[i + c2 - 1]) {
+                auto pos1 = insert_and_copy_upper_bound(a_first + i, a_first + i + c1, r_iter, b1);
+                std::copy(pos1, a_first + i + c2, r_iter);
+                r_iter += std::distance(pos1, a_first + i + c2);
                 j++;
                 i += c2;
                 continue;
             }
 
             // NODE C: Handle case where third element of a is greater than block in b.
-            if ((i + c3 - 1) < m && b3 >= a[i + c3 - 1]) {
-                auto pos1 = insert_and_copy_upper_bound<IterContainer>(a.begin() + i, a.begin() + i + c2, r_iter, b1);
-                auto pos2 = insert_and_copy_upper_bound<IterContainer>(pos1, a.begin() + i + c2 + 1, r_iter, b2);
-                std::copy(pos2, a.begin() + i + c3, r_iter);
-                r_iter += std::distance(pos2, a.begin() + i + c3);
+            if ((i + c3 - 1) < m && b3 >= a_first[i + c3 - 1]) {
+                auto pos1 = insert_and_copy_upper_bound(a_first + i, a_first + i + c2, r_iter, b1);
+                auto pos2 = insert_and_copy_upper_bound(pos1, a_first + i + c2 + 1, r_iter, b2);
+                std::copy(pos2, a_first + i + c3, r_iter);
+                r_iter += std::distance(pos2, a_first + i + c3);
                 j += 2;
                 i += c3;
                 continue;
             }
 
             // NODE D: Handle case where fourth element of a is greater than block in b.
-            if ((i + c4 - 1) < m && b4 >= a[i + c4 - 1]) {            
-                auto pos1 = insert_and_copy_upper_bound<IterContainer>(a.begin() + i, a.begin() + i + c3, r_iter, b1);
-                auto pos2 = insert_and_copy_upper_bound<IterContainer>(pos1, a.begin() + i + c3, r_iter, b2);
-                auto pos3 = insert_and_copy_upper_bound<IterContainer>(pos2, a.begin() + i + c3, r_iter, b3);
+            if ((i + c4 - 1) < m && b4 >= a_first[i + c4 - 1]) {            
+                auto pos1 = insert_and_copy_upper_bound(a_first + i, a_first + i + c3, r_iter, b1);
+                auto pos2 = insert_and_copy_upper_bound(pos1, a_first + i + c3, r_iter, b2);
+                auto pos3 = insert_and_copy_upper_bound(pos2, a_first + i + c3, r_iter, b3);
                 j += 3;
-                i += std::distance(a.begin() + i, pos3);
+                i += std::distance(a_first + i, pos3);
                 continue;
             }
 
             // NODE E: Handle remaining case by inserting all four elements from a into b.
-            auto pos1 = insert_and_copy_upper_bound<IterContainer>(a.begin() + i, a.begin() + i + c4, r_iter, b1);
-            auto pos2 = insert_and_copy_upper_bound<IterContainer>(pos1, a.begin() + i + c4 + 1, r_iter, b2);
-            auto pos3 = insert_and_copy_upper_bound<IterContainer>(pos2, a.begin() + i + c4 + 2, r_iter, b3);
-            auto pos4 = insert_and_copy_upper_bound<IterContainer>(pos3, a.begin() + i + c4 + 3, r_iter, b4);
+            auto pos1 = insert_and_copy_upper_bound(a_first + i, a_first + i + c4, r_iter, b1);
+            auto pos2 = insert_and_copy_upper_bound(pos1, a_first + i + c4 + 1, r_iter, b2);
+            auto pos3 = insert_and_copy_upper_bound(pos2, a_first + i + c4 + 2, r_iter, b3);
+            auto pos4 = insert_and_copy_upper_bound(pos3, a_first + i + c4 + 3, r_iter, b4);
             j += 4;
-            i += std::distance(a.begin() + i, pos4);
+            i += std::distance(a_first + i, pos4);
         }
     }
 
     // Merge remaining elements from both sequences.
-    auto a_it = a.begin() + i;
-    auto b_it = b.begin() + j;
+    auto a_it = a_first + i;
+    auto b_it = b_first + j;
 
     // Merge remaining elements from both arrays.
-    while (a_it != a.end() && b_it != b.end()) {
+    while (a_it != a_last && b_it != b_last) {
         *r_iter++ = (*a_it <= *b_it) ? *a_it++ : *b_it++;
     }
 
     // Copy any remaining elements from a.
-    while (a_it != a.end()) {
+    while (a_it != a_last) {
         *r_iter++ = *a_it++;
     }
 
     // Copy any remaining elements from b.
-    while (b_it != b.end()) {
+    while (b_it != b_last) {
         *r_iter++ = *b_it++;
     }
 
+    return r_iter;
+}
+
+
+/*
+ * Algorithm: Hwang-Lin Dynamic Stable Merge
+ *
+ * Origin:
+ *   Based on:
+ *     Thanh M. and Bui T. D., An Improvement of The Binary Merge Algorithm
+ *     // Concordia University, Montreal, Canada. – 1982. – с.455-462
+ *   Enhancements:
+ *     This implementation extends the original dynamic merge to guarantee stability—
+ *     i.e. when a[i] == b[j], elements from `a` always precede those from `b`.
+ *
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   IterContainer& a - container with a sorted sequence of smaller size.
+ *                      Elements must be in ascending order.
+ *                      IMPORTANT: The container must be accessed starting from its beginning.
+ *
+ *   IterContainer& b - container with a sorted sequence of larger size.
+ *                      Elements must be in ascending order.
+ *                      IMPORTANT: The container must be accessed starting from its beginning.
+ *
+ * Returns:
+ *   IterContainer – new container of size a.size()+b.size(), sorted ascending,
+ *                    with stable ordering: if a[i] == b[j], all from `a` come first.
+ *
+ * Notes:
+ *   - Containers must support the methods size(), reserve(), begin(), end(), insert().
+ *   - It is assumed that the containers a and b are already sorted before calling the function.
+ *
+ */
+template <typename IterContainer>
+IterContainer hwang_lin_dynamic_stable_merge(IterContainer& a, IterContainer& b) {
+    // Return the other container if one is empty.
+    if (a.empty()) {
+        return b;
+    }
+    if (b.empty()) {
+        return a;
+    }
+
+    // Pre-allocate result to avoid reallocations during merge.
+    IterContainer results(a.size() + b.size());
+    hwang_lin_dynamic_stable_merge_into(a.begin(), a.end(), b.begin(), b.end(), results.begin());
     return results;
 }
 
@@ -1004,26 +1148,129 @@ IterContainer fractile_insertion_merge(const IterContainer &a,
     return r;
 }
 
-// SymMerge Algorithm (On a Simple and Stable Merging Algorithm, Pok-Son Kim, Arne Kutzner)
+// Fractile insertion into a preallocated output: inserts the m sorted elements at x into
+// the n sorted elements at y and writes the m + n merged elements to out. Nothing is
+// inserted into a growing container: every pivot is written to its final position and
+// the two subproblems it leaves write disjoint parts of out. fork(left, right, size) runs
+// the two subproblems, either one after the other or as parallel tasks.
+// `x_first` is the tie rule: elements of x precede equal elements of y when true and
+// follow them otherwise. With x_first the probes and the final binary search are those
+// of fractile_insertion_alg, so the comparison count is the same. Without it they are
+// mirrored (<= for <, upper for lower bound): a pivot equal to elements of y lands after
+// them instead of before, which splits y differently, so with keys shared by x and y the
+// later probes, and the count, differ from fractile_insertion_alg (for distinct keys
+// both rules place every pivot alike and the counts match).
+template <typename InputIt, typename OutputIt, typename Fork>
+void fractile_insertion_into_alg(InputIt x, int m, InputIt y, int n, OutputIt out, bool x_first, Fork&& fork) {
+    // trivial case
+    if (m == 0 || n == 0) {
+        if (m) std::copy(x, x + m, out);
+        else   std::copy(y, y + n, out);
+        return;
+    }
+
+    // general case
+    const int f = m / 2;
+    int k = static_cast<int>(std::floor(static_cast<double>(n) * (static_cast<double>(f) / (m + 1.0))));
+    int alpha = static_cast<int>(std::floor(0.5 * std::log2(static_cast<double>(n) * ((1.0 + static_cast<double>(n)) / m)) - 1.3));
+    int delta = alpha < 0 ? 1 : 1 << alpha;
+
+    const auto& x_piv = x[f];
+
+    int left  = 0;
+    int right = n;
+    int pos;
+
+    if (x_first) {
+        if (x_piv > y[k]) {                     // go right
+            left = k + 1;
+            int idx = k + delta;
+            while (idx < n && y[idx] < x_piv) {
+                left = idx + 1;
+                idx += delta;
+            }
+            right = std::min(idx, n);
+        } else {                                // go left
+            right = k;
+            int idx = k - delta;
+            while (idx >= 0 && y[idx] >= x_piv) {
+                right = idx;
+                idx -= delta;
+            }
+            left = std::max(0, idx + 1);
+        }
+        pos = static_cast<int>(std::lower_bound(y + left, y + right, x_piv) - y);
+    } else {
+        // Mirror image: equal elements of y stay before the pivot.
+        if (x_piv >= y[k]) {                    // go right
+            left = k + 1;
+            int idx = k + delta;
+            while (idx < n && y[idx] <= x_piv) {
+                left = idx + 1;
+                idx += delta;
+            }
+            right = std::min(idx, n);
+        } else {                                // go left
+            right = k;
+            int idx = k - delta;
+            while (idx >= 0 && y[idx] > x_piv) {
+                right = idx;
+                idx -= delta;
+            }
+            left = std::max(0, idx + 1);
+        }
+        pos = static_cast<int>(std::upper_bound(y + left, y + right, x_piv) - y);
+    }
+
+    out[f + pos] = x_piv;
+
+    fork([&] { fractile_insertion_into_alg(x, f, y, pos, out, x_first, fork); },
+         [&] { fractile_insertion_into_alg(x + f + 1, m - f - 1, y + pos, n - pos, out + f + pos + 1, x_first, fork); },
+         static_cast<std::size_t>(m) + static_cast<std::size_t>(n));
+}
+
+// Sequential fractile insertion into out (m + n elements). Unlike fractile_insertion_merge
+// it is stable in both orientations: the smaller sequence is inserted into the larger one,
+// and elements of a always precede equal elements of b. The comparison count equals
+// fractile_insertion_merge for m <= n; for m > n only when no key of b occurs in a, as
+// b is then inserted with the mirrored tie rule (see fractile_insertion_into_alg).
+template <typename InputIt, typename OutputIt>
+OutputIt fractile_insertion_merge_into(InputIt a_first, InputIt a_last, InputIt b_first, InputIt b_last, OutputIt out) {
+    const int m = static_cast<int>(std::distance(a_first, a_last));
+    const int n = static_cast<int>(std::distance(b_first, b_last));
+    auto sequential = [](auto&& left, auto&& right, std::size_t) { left(); right(); };
+
+    if (m <= n) {
+        fractile_insertion_into_alg(a_first, m, b_first, n, out, true, sequential);
+    } else {
+        fractile_insertion_into_alg(b_first, n, a_first, m, out, false, sequential);
+    }
+    return out + (m + n);
+}
+
+// One level of SymMerge: handles the trivial cases, finds the symmetric split and rotates.
+// Returns the two independent subproblems that are left (either may be empty).
 template <typename IterContainer>
-void simple_kim_kutzner_alg(IterContainer begin, IterContainer separator, IterContainer end) {
+std::array<MergeRange<IterContainer>, 2> simple_kim_kutzner_split(IterContainer begin, IterContainer separator, IterContainer end) {
     using diff_t = typename std::iterator_traits<IterContainer>::difference_type;
     diff_t left_size = std::distance(begin, separator);  // |u|
     diff_t right_size = std::distance(separator, end);   // |v|
 
+    const std::array<MergeRange<IterContainer>, 2> done{{{begin, begin, begin}, {end, end, end}}};
+
     // trivial case
-    if (left_size == 0 || right_size == 0) return;
+    if (left_size == 0 || right_size == 0) return done;
 
     // if |u| or |v| equal 1
     if (left_size == 1) {
         IterContainer it = std::lower_bound(separator, end, *begin);
         std::rotate(begin, std::next(begin), it);
-        return;
+        return done;
     }
     if (right_size == 1) {
         IterContainer it = std::upper_bound(begin, separator, *separator);
         std::rotate(it, separator, std::next(separator));
-        return;
+        return done;
     }
 
     // general case
@@ -1062,11 +1309,17 @@ void simple_kim_kutzner_alg(IterContainer begin, IterContainer separator, IterCo
         std::rotate(s, separator, e);
     }
 
-    if (s_off > 0 && s_off < mid_off) {
-        simple_kim_kutzner_alg(begin, s, mid);
-    }
-    if (e_off > mid_off && e_off < total_size) {
-        simple_kim_kutzner_alg(mid, e, end);
+    // [begin, s, mid) is empty unless 0 < s_off < mid_off, [mid, e, end) unless mid_off < e_off < total_size.
+    return {{{begin, s, mid}, {mid, e, end}}};
+}
+
+// SymMerge Algorithm (On a Simple and Stable Merging Algorithm, Pok-Son Kim, Arne Kutzner)
+template <typename IterContainer>
+void simple_kim_kutzner_alg(IterContainer begin, IterContainer separator, IterContainer end) {
+    for (const auto& part : simple_kim_kutzner_split(begin, separator, end)) {
+        if (!part.empty()) {
+            simple_kim_kutzner_alg(part.first, part.separator, part.last);
+        }
     }
 }
 
@@ -1315,38 +1568,42 @@ IterContainer unstable_core_kim_kutzner_merge(IterContainer& a, IterContainer& b
 }
 
 
+// One level of SplitMerge: simultaneous binary searches in u = [first1, first2) and
+// v = [first2, last) halve both ranges until one of them is empty; the split point in
+// the other one is then found by a binary search. The middle runs are rotated and the
+// two independent subproblems that are left are returned (either may be empty).
+// Elements of u precede equal elements of v.
 template <typename RandomIt>
-void split_merge_alg(RandomIt first1, RandomIt first2, RandomIt last) {
+std::array<MergeRange<RandomIt>, 2> split_merge_split(RandomIt first1, RandomIt first2, RandomIt last) {
+    const std::array<MergeRange<RandomIt>, 2> done{{{first1, first1, first1}, {last, last, last}}};
+
     if (first1 >= first2 || first2 >= last) {
-        return;
+        return done;
     }
 
     auto len1 = std::distance(first1, first2);
     auto len2 = std::distance(first2, last);
-    if (len1 == 0 || len2 == 0) return;
-
 
     if (len1 == 1) {
         auto it = std::lower_bound(first2, last, *first1);
         std::rotate(first1, first2, it);
-        return;
+        return done;
     }
     if (len2 == 1) {
         auto it = std::upper_bound(first1, first2, *first2);
         std::rotate(it, first2, last);
-        return;
+        return done;
     }
 
 
     RandomIt l = first1, r = first2;
     RandomIt l2 = first2, r2 = last;
 
-    // symmetric splitting: shrink [l,r) and [l2,r2) until both collapse to single elements
+    // symmetric splitting: shrink [l,r) and [l2,r2) until one of them is empty.
+    // Invariants: *(l-1) <= *r2 and *(l2-1) < *r whenever these elements exist.
     while (l < r && l2 < r2) {
-        RandomIt m  = l;
-        RandomIt m2 = l2;
-        if (l < r)   m  = l  + (r  - l)  / 2;
-        if (l2 < r2) m2 = l2 + (r2 - l2) / 2;
+        RandomIt m  = l  + (r  - l)  / 2;
+        RandomIt m2 = l2 + (r2 - l2) / 2;
 
         if (*m <= *m2) {
             l  = m  + 1;
@@ -1357,20 +1614,31 @@ void split_merge_alg(RandomIt first1, RandomIt first2, RandomIt last) {
         }
     }
 
+    // split points: u at r, v at l2
+    if (l < r) {
+        // v is split at l2 == r2: u elements not greater than *(l2-1) stay on the left.
+        r = (l2 == first2) ? l : std::upper_bound(l, r, *std::prev(l2));
+    } else if (l2 < r2) {
+        // u is split at r == l: v elements less than *(r-1) move to the left.
+        if (r != first1) l2 = std::lower_bound(l2, r2, *std::prev(r));
+    }
+
     // now [r, first2) and [first2, l2) are the two middle runs to swap:
     //    u′3 = [r, first2)   and   v′1 = [first2, l2)
-    std::rotate(r, first2, l2);
-
-    // recursive calls on the two halves:
-    //  left half:  [first1, r) U [r, r + (l2-first2))  == [first1, r + (l2-first2))
-    split_merge_alg(first1,
-                r,
-                r + (r2 - first2));
-
-    // right half: [l + (l2-first2), l2) U [l2, last) == [l + (l2-first2), last)
-    split_merge_alg(l + (l2 - first2),
-                l2,
-                last);
+    RandomIt mid = std::rotate(r, first2, l2);
+
+    //  left half:  [first1, r) U [r, mid)
+    //  right half: [mid, l2) U [l2, last)
+    return {{{first1, r, mid}, {mid, l2, last}}};
+}
+
+template <typename RandomIt>
+void split_merge_alg(RandomIt first1, RandomIt first2, RandomIt last) {
+    for (const auto& part : split_merge_split(first1, first2, last)) {
+        if (!part.empty()) {
+            split_merge_alg(part.first, part.separator, part.last);
+        }
+    }
 }
 
 /*
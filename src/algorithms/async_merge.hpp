@@ -0,0 +1,425 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Coroutine-based merge of asynchronous sorted streams: a single-threaded executor
+ *              with timers, detached tasks, bounded channels and an async chunk generator.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "algorithms.hpp"
+
+
+class AsyncExecutor;
+
+/*
+ * Detached coroutine started by AsyncExecutor::spawn.
+ *
+ * The coroutine starts suspended and is first resumed by the executor. Its frame is
+ * destroyed by the executor once it has finished; an exception escaping it is rethrown
+ * from AsyncExecutor::run.
+ */
+class AsyncTask {
+public:
+    struct promise_type {
+        std::exception_ptr exception;
+
+        AsyncTask get_return_object() {
+            return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    AsyncTask(AsyncTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    AsyncTask(const AsyncTask&) = delete;
+    AsyncTask& operator=(const AsyncTask&) = delete;
+
+    ~AsyncTask() {
+        if (handle_) handle_.destroy();
+    }
+
+private:
+    friend class AsyncExecutor;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/*
+ * Single-threaded executor: a queue of ready coroutines and a queue of timers.
+ *
+ * run() resumes ready coroutines in FIFO order; when none is ready it sleeps until the
+ * earliest timer. It returns when there is nothing ready and no timer left, which with
+ * well-formed programs means every spawned task has finished.
+ *
+ * Notes:
+ *   - Not thread-safe: coroutines must be scheduled from the thread that calls run().
+ */
+class AsyncExecutor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AsyncExecutor() = default;
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    void spawn(AsyncTask task) {
+        auto handle = std::exchange(task.handle_, {});
+        tasks_.push_back(handle);
+        schedule(handle);
+    }
+
+    void schedule(std::coroutine_handle<> handle) {
+        ready_.push_back(handle);
+    }
+
+    void schedule_at(Clock::time_point when, std::coroutine_handle<> handle) {
+        timers_.push({when, sequence_++, handle});
+    }
+
+    // co_await executor.sleep_for(duration) suspends the calling coroutine for `duration`.
+    auto sleep_for(Clock::duration duration) {
+        struct Awaiter {
+            AsyncExecutor*    executor;
+            Clock::time_point when;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor->schedule_at(when, handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, Clock::now() + duration};
+    }
+
+    void run() {
+        while (true) {
+            while (!timers_.empty() && timers_.top().when <= Clock::now()) {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            }
+            if (!ready_.empty()) {
+                auto handle = ready_.front();
+                ready_.pop_front();
+                handle.resume();
+                continue;
+            }
+            if (timers_.empty()) break;
+            std::this_thread::sleep_until(timers_.top().when);
+        }
+
+        std::exception_ptr exception;
+        for (auto handle : tasks_) {
+            if (!exception && handle.done()) exception = handle.promise().exception;
+            handle.destroy();
+        }
+        tasks_.clear();
+        if (exception) std::rethrow_exception(exception);
+    }
+
+private:
+    struct Timer {
+        Clock::time_point       when;
+        std::size_t             sequence; // FIFO order among equal deadlines.
+        std::coroutine_handle<> handle;
+
+        bool operator>(const Timer& other) const {
+            return when != other.when ? when > other.when : sequence > other.sequence;
+        }
+    };
+
+    std::deque<std::coroutine_handle<>>                                 ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    std::size_t                                                         sequence_ = 0;
+    std::vector<std::coroutine_handle<AsyncTask::promise_type>>         tasks_;
+};
+
+/*
+ * Bounded single-consumer channel of T between coroutines on one executor.
+ *
+ * co_await send(value) completes immediately while fewer than `capacity` values are
+ * queued and otherwise suspends the sender until the consumer has taken one, so a
+ * producer can never run more than `capacity` values ahead of its consumer.
+ * co_await receive() yields the next value, or std::nullopt once the channel is closed
+ * and drained.
+ *
+ * Notes:
+ *   - At most one coroutine may wait in receive() at a time.
+ */
+template <typename T>
+class AsyncChannel {
+public:
+    AsyncChannel(AsyncExecutor& executor, std::size_t capacity)
+        : executor_(executor), capacity_(std::max<std::size_t>(capacity, 1)) {}
+
+    AsyncChannel(const AsyncChannel&) = delete;
+    AsyncChannel& operator=(const AsyncChannel&) = delete;
+
+    auto send(T value) {
+        struct Awaiter {
+            AsyncChannel* channel;
+            T             value;
+
+            bool await_ready() {
+                if (channel->queue_.size() >= channel->capacity_) return false;
+                channel->push(std::move(value));
+                return true;
+            }
+            void await_suspend(std::coroutine_handle<> handle) {
+                channel->senders_.push_back({handle, &value});
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{this, std::move(value)};
+    }
+
+    auto receive() {
+        struct Awaiter {
+            AsyncChannel* channel;
+
+            bool await_ready() const noexcept {
+                return !channel->queue_.empty() || channel->closed_;
+            }
+            void await_suspend(std::coroutine_handle<> handle) {
+                channel->receiver_ = handle;
+            }
+            std::optional<T> await_resume() {
+                if (channel->queue_.empty()) return std::nullopt;
+                std::optional<T> value(std::move(channel->queue_.front()));
+                channel->queue_.pop_front();
+                channel->admitSender();
+                return value;
+            }
+        };
+        return Awaiter{this};
+    }
+
+    // No more values will be sent; the consumer drains what is queued.
+    void close() {
+        closed_ = true;
+        wakeReceiver();
+    }
+
+    // Largest number of values that were queued at once.
+    std::size_t high_water() const { return high_water_; }
+
+private:
+    struct Sender {
+        std::coroutine_handle<> handle;
+        T*                      value;   // Lives in the suspended sender's awaiter.
+    };
+
+    void push(T value) {
+        queue_.push_back(std::move(value));
+        high_water_ = std::max(high_water_, queue_.size());
+        wakeReceiver();
+    }
+
+    // A value was taken: the oldest blocked sender may put its value in the queue.
+    void admitSender() {
+        if (senders_.empty() || queue_.size() >= capacity_) return;
+        Sender sender = senders_.front();
+        senders_.pop_front();
+        push(std::move(*sender.value));
+        executor_.schedule(sender.handle);
+    }
+
+    void wakeReceiver() {
+        if (receiver_) executor_.schedule(std::exchange(receiver_, {}));
+    }
+
+    AsyncExecutor&          executor_;
+    std::size_t             capacity_;
+    std::deque<T>           queue_;
+    std::deque<Sender>      senders_;
+    std::coroutine_handle<> receiver_;
+    bool                    closed_ = false;
+    std::size_t             high_water_ = 0;
+};
+
+/*
+ * Asynchronous generator of T.
+ *
+ * The coroutine body produces values with co_yield and may co_await anything in between
+ * (channels, timers, other generators). The consumer pulls with
+ *   while (auto value = co_await stream.next()) { ... }
+ * The body only runs while a consumer waits in next(), so a generator never produces
+ * ahead of its consumer: this is the backpressure of the merge tree.
+ */
+template <typename T>
+class AsyncStream {
+public:
+    struct promise_type {
+        std::optional<T>        current;
+        std::coroutine_handle<> consumer;
+        std::exception_ptr      exception;
+
+        AsyncStream get_return_object() {
+            return AsyncStream(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        // Hands control back to the consumer waiting in next().
+        struct Yield {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                return handle.promise().consumer;
+            }
+            void await_resume() const noexcept {}
+        };
+
+        Yield yield_value(T value) {
+            current = std::move(value);
+            return {};
+        }
+        Yield final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+    AsyncStream(AsyncStream&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    AsyncStream& operator=(AsyncStream&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    AsyncStream(const AsyncStream&) = delete;
+    AsyncStream& operator=(const AsyncStream&) = delete;
+
+    ~AsyncStream() {
+        if (handle_) handle_.destroy();
+    }
+
+    // co_await next() resumes the generator until its next co_yield (value) or its end (nullopt).
+    auto next() {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> consumer) noexcept {
+                handle.promise().consumer = consumer;
+                return handle;
+            }
+            std::optional<T> await_resume() {
+                auto& promise = handle.promise();
+                if (promise.exception) std::rethrow_exception(std::exchange(promise.exception, {}));
+                return std::exchange(promise.current, std::nullopt);
+            }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    explicit AsyncStream(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+// Stream of the values received from a channel until it is closed.
+template <typename T>
+AsyncStream<T> async_receive_all(AsyncChannel<T>& channel) {
+    while (auto value = co_await channel.receive()) {
+        co_yield std::move(*value);
+    }
+}
+
+/*
+ * Algorithm: Asynchronous Chunked Merge
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   AsyncStream<std::vector<T>> a, b - streams of sorted chunks; the concatenation of
+ *                                      each stream's chunks is sorted.
+ *   std::size_t chunk_size           - minimum size of an output chunk (except the last).
+ *
+ * Return Value:
+ *   AsyncStream<std::vector<T>> - merged chunks; stable (a before b on equal elements).
+ *
+ * Notes:
+ *   - Only the part that cannot change any more is emitted: if a's last buffered element
+ *     is not greater than b's, all of a's chunk and the elements of b's chunk below it;
+ *     otherwise all of b's chunk and the elements of a's chunk up to it. That part is
+ *     merged with hwang_lin_static_stable_merge_into, so skewed chunks cost few comparisons.
+ *   - A new chunk is awaited only from the input whose chunk was used up; at most one
+ *     chunk per input plus one output chunk is buffered.
+ */
+template <typename T>
+AsyncStream<std::vector<T>> async_merge(AsyncStream<std::vector<T>> a, AsyncStream<std::vector<T>> b,
+                                        std::size_t chunk_size) {
+    std::vector<T> chunk_a, chunk_b, pending;
+    std::size_t pos_a = 0, pos_b = 0;
+    bool done_a = false, done_b = false;
+
+    while (true) {
+        // Refill an exhausted input; empty chunks are skipped.
+        if (pos_a == chunk_a.size() && !done_a) {
+            auto chunk = co_await a.next();
+            if (chunk) { chunk_a = std::move(*chunk); pos_a = 0; } else done_a = true;
+            continue;
+        }
+        if (pos_b == chunk_b.size() && !done_b) {
+            auto chunk = co_await b.next();
+            if (chunk) { chunk_b = std::move(*chunk); pos_b = 0; } else done_b = true;
+            continue;
+        }
+
+        const bool empty_a = pos_a == chunk_a.size();
+        const bool empty_b = pos_b == chunk_b.size();
+        if (empty_a && empty_b) break;
+
+        auto first_a = chunk_a.begin() + pos_a, last_a = chunk_a.end();
+        auto first_b = chunk_b.begin() + pos_b, last_b = chunk_b.end();
+        if (!empty_a && !empty_b) {
+            if (!(chunk_b.back() < chunk_a.back())) {
+                last_b = std::lower_bound(first_b, last_b, chunk_a.back());
+            } else {
+                last_a = std::upper_bound(first_a, last_a, chunk_b.back());
+            }
+        }
+
+        const std::size_t offset = pending.size();
+        pending.resize(offset + (last_a - first_a) + (last_b - first_b));
+        hwang_lin_static_stable_merge_into(first_a, last_a, first_b, last_b, pending.begin() + offset);
+        pos_a = static_cast<std::size_t>(last_a - chunk_a.begin());
+        pos_b = static_cast<std::size_t>(last_b - chunk_b.begin());
+
+        if (pending.size() >= chunk_size) {
+            co_yield std::exchange(pending, {});
+        }
+    }
+    if (!pending.empty()) co_yield std::move(pending);
+}
+
+// Merges any number of streams with a balanced tree of async_merge (stable: earlier
+// streams first on equal elements).
+template <typename T>
+AsyncStream<std::vector<T>> async_merge(std::vector<AsyncStream<std::vector<T>>> streams, std::size_t chunk_size) {
+    while (streams.size() > 1) {
+        std::vector<AsyncStream<std::vector<T>>> next;
+        for (std::size_t i = 0; i + 1 < streams.size(); i += 2) {
+            next.push_back(async_merge(std::move(streams[i]), std::move(streams[i + 1]), chunk_size));
+        }
+        if (streams.size() % 2) next.push_back(std::move(streams.back()));
+        streams = std::move(next);
+    }
+    if (streams.empty()) return [] () -> AsyncStream<std::vector<T>> { co_return; }();
+    return std::move(streams.front());
+}
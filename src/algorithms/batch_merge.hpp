@@ -0,0 +1,203 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Batch API for many small independent merges: jobs are grouped by size
+ *              class and run on a fixed thread pool with per-thread scratch space.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "thread_pool.hpp"
+
+
+// One merge of a batch: `out` receives the merge of `a` and `b` and must hold exactly
+// a.size() + b.size() elements. Inputs and outputs of different jobs must not overlap.
+template <typename T>
+struct MergeJob {
+    std::span<const T> a;
+    std::span<const T> b;
+    std::span<T>       out;
+};
+
+// Working memory of one worker thread, reused by every job it runs.
+template <typename T>
+struct BatchMergeScratch {
+    std::vector<T> first;
+    std::vector<T> second;
+};
+
+
+/*
+ * Merge kernels.
+ *
+ * A kernel is a stateless functor
+ *   void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const
+ * that is a template parameter of BatchMerger, so every job is a direct (inlinable)
+ * call - no virtual dispatch and no allocation per job. Each kernel produces exactly
+ * what the container API of the same algorithm returns.
+ */
+
+struct TwoWayMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const {
+        two_way_merge_into(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+    }
+};
+
+struct HwangLinStaticMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const {
+        hwang_lin_static_merge_into(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+    }
+};
+
+// The in-place algorithms copy both inputs into `out` and merge there.
+struct HwangLinStaticKutznerMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const {
+        // Same layout as hwang_lin_static_kutzner_merge: the larger sequence goes first.
+        const bool a_first = a.size() >= b.size();
+        std::span<const T> first  = a_first ? a : b;
+        std::span<const T> second = a_first ? b : a;
+        auto separator = std::copy(first.begin(), first.end(), out.begin());
+        std::copy(second.begin(), second.end(), separator);
+        hwang_lin_static_kutzner(out.begin(), separator, out.end());
+    }
+};
+
+struct SimpleKimKutznerMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const {
+        auto separator = std::copy(a.begin(), a.end(), out.begin());
+        std::copy(b.begin(), b.end(), separator);
+        simple_kim_kutzner_alg(out.begin(), separator, out.end());
+    }
+};
+
+struct UnstableCoreKimKutznerMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>&) const {
+        auto separator = std::copy(a.begin(), a.end(), out.begin());
+        std::copy(b.begin(), b.end(), separator);
+        unstable_core_kim_kutzner(out.begin(), separator, out.end());
+    }
+};
+
+// Fractile insertion inserts into a growing container; the scratch vectors keep
+// their capacity between jobs, so after warm-up no job allocates.
+struct FractileInsertionMergeKernel {
+    template <typename T>
+    void operator()(std::span<const T> a, std::span<const T> b, std::span<T> out, BatchMergeScratch<T>& scratch) const {
+        const bool insert_a = a.size() <= b.size();
+        std::span<const T> inserted = insert_a ? a : b;
+        std::span<const T> target   = insert_a ? b : a;
+
+        scratch.first.assign(inserted.begin(), inserted.end());
+        scratch.second.reserve(a.size() + b.size());
+        scratch.second.assign(target.begin(), target.end());
+        fractile_insertion_alg(scratch.first.cbegin(), static_cast<int>(scratch.first.size()),
+                               scratch.second, 0, scratch.second.size());
+        std::copy(scratch.second.begin(), scratch.second.end(), out.begin());
+    }
+};
+
+
+/*
+ * Runs batches of independent merges with one kernel on a thread pool.
+ *
+ * Jobs are bucketed by size class (bit width of |A| + |B|) and each class is cut
+ * into tasks of about `task_elements` merged elements, so a task is many tiny jobs
+ * or a few larger ones and every task costs roughly the same. Larger classes are
+ * scheduled first. The bucket and task arrays and the per-thread scratch are kept
+ * between calls of run().
+ *
+ * Parameters:
+ *   pool          - worker threads (shared with other users, one batch at a time).
+ *   kernel        - merge kernel, e.g. TwoWayMergeKernel.
+ *   task_elements - target number of merged elements per task (default: 16K).
+ */
+template <typename T, typename Kernel>
+class BatchMerger {
+public:
+    explicit BatchMerger(ThreadPool& pool, Kernel kernel = {}, std::size_t task_elements = std::size_t{1} << 14)
+        : pool_(pool), kernel_(kernel), task_elements_(std::max<std::size_t>(task_elements, 1)),
+          scratch_(pool.size()) {}
+
+    void run(std::span<const MergeJob<T>> jobs) {
+        for (const auto& job : jobs) {
+            if (job.out.size() != job.a.size() + job.b.size()) {
+                throw std::invalid_argument("BatchMerger: output size must equal |A| + |B|.");
+            }
+        }
+
+        plan(jobs);
+
+        pool_.parallel_for(tasks_.size(), [&](std::size_t worker, std::size_t task) {
+            auto [first, last] = tasks_[task];
+            for (std::size_t i = first; i < last; ++i) {
+                const MergeJob<T>& job = jobs[order_[i]];
+                kernel_(job.a, job.b, job.out, scratch_[worker]);
+            }
+        });
+    }
+
+private:
+    static constexpr std::size_t kClasses = 65; // bit widths 0..64
+
+    // Bucket of a job: 0 for the largest size class, kClasses - 1 for empty jobs.
+    static std::size_t bucket(const MergeJob<T>& job) {
+        return kClasses - 1 - static_cast<std::size_t>(std::bit_width(job.out.size()));
+    }
+
+    // Counting sort of the jobs by size class (largest first), then cuts each class into tasks.
+    void plan(std::span<const MergeJob<T>> jobs) {
+        std::size_t start[kClasses + 1] = {};
+        for (const auto& job : jobs) start[bucket(job)]++;
+        for (std::size_t c = 0, sum = 0; c <= kClasses; ++c) {
+            std::size_t count = start[c];
+            start[c] = sum;
+            sum += count;
+        }
+
+        order_.resize(jobs.size());
+        std::size_t fill[kClasses + 1];
+        std::copy(std::begin(start), std::end(start), std::begin(fill));
+        for (std::size_t i = 0; i < jobs.size(); ++i) {
+            order_[fill[bucket(jobs[i])]++] = i;
+        }
+
+        tasks_.clear();
+        for (std::size_t c = 0; c < kClasses; ++c) {
+            std::size_t first = start[c];
+            std::size_t last = start[c + 1];
+            if (first == last) continue;
+            std::size_t width = kClasses - 1 - c; // jobs here have fewer than 2^width elements
+            std::size_t per_task = std::max<std::size_t>(task_elements_ >> (width ? width - 1 : 0), 1);
+            for (std::size_t i = first; i < last; i += per_task) {
+                tasks_.emplace_back(i, std::min(i + per_task, last));
+            }
+        }
+    }
+
+    ThreadPool&                                      pool_;
+    Kernel                                           kernel_;
+    std::size_t                                      task_elements_;
+    std::vector<BatchMergeScratch<T>>                scratch_;
+    std::vector<std::size_t>                         order_;
+    std::vector<std::pair<std::size_t, std::size_t>> tasks_;
+};
+
+// Runs one batch of merges; prefer a long-lived BatchMerger for repeated batches.
+template <typename Kernel, typename T>
+void batch_merge(ThreadPool& pool, std::span<const MergeJob<T>> jobs, Kernel kernel = {}) {
+    BatchMerger<T, Kernel> merger(pool, kernel);
+    merger.run(jobs);
+}
@@ -22,6 +22,17 @@ using std::bit_floor;
 
 constexpr int pow2(int t) { return 1<<t; } // Raise a number to the power of 2 using a bitwise operator
 
+// Subproblem of a divide-and-conquer in-place merge: merge [first, separator) with [separator, last).
+template <typename It>
+struct MergeRange {
+    It first;
+    It separator;
+    It last;
+
+    // Nothing to merge when either side is empty.
+    bool empty() const { return first == separator || separator == last; }
+};
+
 // Insert element in container in specified range
 template <typename IterContainer>
 std::size_t stable_insert(
@@ -73,32 +84,30 @@ It search_minimal_block(std::ptrdiff_t k,
 
 // Insert element and copy elements before insertion point using lower_bound.
 // Used when merging A and B (A < B) to place elements from A before equal elements from B.
-template <typename IterContainer>
-typename IterContainer::iterator insert_and_copy_lower_bound(
-    typename IterContainer::iterator start,
-    typename IterContainer::iterator end,
-    typename IterContainer::iterator& r_iter,
-    const typename IterContainer::value_type& value
+template <typename InputIt, typename OutputIt>
+InputIt insert_and_copy_lower_bound(
+    InputIt start,
+    InputIt end,
+    OutputIt& r_iter,
+    const typename std::iterator_traits<InputIt>::value_type& value
 ) {
     auto pos = std::lower_bound(start, end, value);
-    std::copy(start, pos, r_iter);
-    r_iter += std::distance(start, pos);
+    r_iter = std::copy(start, pos, r_iter);
     *r_iter++ = value;
     return pos;
 }
 
 // Insert element and copy elements before insertion point using upper_bound.
 // Used when merging A and B (A > B) to place elements from B after equal elements from A.
-template <typename IterContainer>
-typename IterContainer::iterator insert_and_copy_upper_bound(
-    typename IterContainer::iterator start,
-    typename IterContainer::iterator end,
-    typename IterContainer::iterator& r_iter,
-    const typename IterContainer::value_type& value
+template <typename InputIt, typename OutputIt>
+InputIt insert_and_copy_upper_bound(
+    InputIt start,
+    InputIt end,
+    OutputIt& r_iter,
+    const typename std::iterator_traits<InputIt>::value_type& value
 ) {
     auto pos = std::upper_bound(start, end, value);
-    std::copy(start, pos, r_iter);
-    r_iter += std::distance(start, pos);
+    r_iter = std::copy(start, pos, r_iter);
     *r_iter++ = value;
     return pos;
 }
@@ -0,0 +1,347 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: External-memory merge of sorted run files (raw arrays of T) through mmap,
+ *              with Hwang-Lin block skipping and bulk page copies for untouched blocks.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common.hpp"
+
+
+// Read-only memory mapping of a run file holding a raw array of T.
+template <typename T>
+class MappedRun {
+    static_assert(std::is_trivially_copyable_v<T>, "run files store raw trivially copyable elements");
+
+public:
+    explicit MappedRun(const std::string& path) {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("MappedRun: unable to open " + path + ": " + std::strerror(errno));
+        }
+
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("MappedRun: unable to stat " + path + ": " + std::strerror(errno));
+        }
+        bytes_ = static_cast<std::size_t>(st.st_size);
+        if (bytes_ % sizeof(T) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("MappedRun: size of " + path + " is not a multiple of the element size.");
+        }
+
+        if (bytes_ > 0) {
+            void* p = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd_);
+                throw std::runtime_error("MappedRun: unable to map " + path + ": " + std::strerror(errno));
+            }
+            data_ = static_cast<const T*>(p);
+            // The merge reads each run front to back exactly once.
+            ::madvise(p, bytes_, MADV_SEQUENTIAL);
+        }
+    }
+
+    MappedRun(const MappedRun&) = delete;
+    MappedRun& operator=(const MappedRun&) = delete;
+
+    ~MappedRun() {
+        if (data_) ::munmap(const_cast<T*>(data_), bytes_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    const T*    data() const { return data_; }
+    std::size_t size() const { return bytes_ / sizeof(T); }
+    int         fd()   const { return fd_; }
+
+private:
+    int         fd_ = -1;
+    const T*    data_ = nullptr;
+    std::size_t bytes_ = 0;
+};
+
+// Counters describing how the output of an external merge was produced.
+struct ExternalMergeStats {
+    std::size_t elements = 0;          // Total elements written.
+    std::size_t bulk_elements = 0;     // Elements written as whole ranges straight from a run.
+    std::size_t bulk_calls = 0;        // Number of such ranges.
+    std::size_t kernel_copy_bytes = 0; // Bytes moved with copy_file_range (never read by the merge).
+};
+
+/*
+ * Appends elements to the output file.
+ *
+ * Small pieces are gathered in a buffer. Ranges of at least `bulk_bytes` taken
+ * directly from a run bypass the buffer: they are copied file-to-file with
+ * copy_file_range, falling back to a plain pwrite from the mapping when the
+ * kernel or file system cannot do that.
+ */
+template <typename T>
+class RunFileWriter {
+public:
+    RunFileWriter(const std::string& path, std::size_t buffer_bytes, std::size_t bulk_bytes, ExternalMergeStats& stats)
+        : stats_(stats), bulk_bytes_(bulk_bytes) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("RunFileWriter: unable to open " + path + ": " + std::strerror(errno));
+        }
+        buffer_.reserve(std::max<std::size_t>(buffer_bytes / sizeof(T), 1));
+    }
+
+    RunFileWriter(const RunFileWriter&) = delete;
+    RunFileWriter& operator=(const RunFileWriter&) = delete;
+
+    ~RunFileWriter() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void push(const T& value) {
+        buffer_.push_back(value);
+        if (buffer_.size() == buffer_.capacity()) flush();
+    }
+
+    // Appends run.data()[first, first + count).
+    void append(const MappedRun<T>& run, std::size_t first, std::size_t count) {
+        if (count == 0) return;
+        const std::size_t bytes = count * sizeof(T);
+
+        if (bytes < bulk_bytes_) {
+            const T* src = run.data() + first;
+            for (std::size_t done = 0; done < count;) {
+                std::size_t take = std::min(count - done, buffer_.capacity() - buffer_.size());
+                buffer_.insert(buffer_.end(), src + done, src + done + take);
+                done += take;
+                if (buffer_.size() == buffer_.capacity()) flush();
+            }
+            return;
+        }
+
+        flush();
+        stats_.bulk_elements += count;
+        stats_.bulk_calls++;
+
+        loff_t in_off = static_cast<loff_t>(first * sizeof(T));
+        std::size_t left = bytes;
+        while (left > 0 && use_kernel_copy_) {
+            ssize_t n = ::copy_file_range(run.fd(), &in_off, fd_, &offset_, left, 0);
+            if (n <= 0) {
+                use_kernel_copy_ = false; // e.g. EXDEV or ENOSYS: finish with pwrite below.
+                break;
+            }
+            left -= static_cast<std::size_t>(n);
+            stats_.kernel_copy_bytes += static_cast<std::size_t>(n);
+        }
+        if (left > 0) {
+            write_all(reinterpret_cast<const char*>(run.data() + first) + (bytes - left), left);
+        }
+    }
+
+    void flush() {
+        if (buffer_.empty()) return;
+        write_all(reinterpret_cast<const char*>(buffer_.data()), buffer_.size() * sizeof(T));
+        buffer_.clear();
+    }
+
+private:
+    void write_all(const char* p, std::size_t len) {
+        while (len > 0) {
+            ssize_t n = ::pwrite(fd_, p, len, offset_);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("RunFileWriter: write failed: ") + std::strerror(errno));
+            }
+            p += n;
+            len -= static_cast<std::size_t>(n);
+            offset_ += n;
+        }
+    }
+
+    int                 fd_ = -1;
+    loff_t              offset_ = 0;
+    std::vector<T>      buffer_;
+    ExternalMergeStats& stats_;
+    std::size_t         bulk_bytes_;
+    bool                use_kernel_copy_ = true;
+};
+
+
+/*
+ * Two-way external merge: forward Hwang-Lin static merge over two mapped runs.
+ *
+ * With m = |smaller run|, n = |larger run| and t = floor(log2(n/m)), the next 2^t
+ * elements of the larger run are skipped by one comparison of their last element
+ * with the head of the smaller run. Consecutive skipped blocks are written as one
+ * range, so untouched pages are never read by the merge itself.
+ * On equal keys elements of `a` come first.
+ */
+template <typename T>
+void external_merge_two(const MappedRun<T>& a, const MappedRun<T>& b, RunFileWriter<T>& out) {
+    const bool large_is_a = a.size() > b.size();
+    const MappedRun<T>& small = large_is_a ? b : a;
+    const MappedRun<T>& large = large_is_a ? a : b;
+    const T* S = small.data();
+    const T* L = large.data();
+    const std::size_t m = small.size();
+    const std::size_t n = large.size();
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    if (m != 0 && n != 0) {
+        int t = static_cast<int>(std::floor(std::log2(static_cast<double>(n) / m)));
+        std::size_t pow2t = static_cast<std::size_t>(pow2(std::max(t, 0)));
+        std::size_t pending = j; // start of the large-run range not yet written
+
+        while (i < m && n - j >= pow2t) {
+            const T& last = L[j + pow2t - 1];
+            bool block_first = large_is_a ? !(S[i] < last) : last < S[i];
+
+            if (block_first) {
+                j += pow2t;
+                continue;
+            }
+
+            const T* pos = large_is_a
+                ? std::upper_bound(L + j, L + j + pow2t - 1, S[i])
+                : std::lower_bound(L + j, L + j + pow2t - 1, S[i]);
+            j = static_cast<std::size_t>(pos - L);
+            out.append(large, pending, j - pending);
+            out.push(S[i++]);
+            pending = j;
+        }
+        out.append(large, pending, j - pending);
+
+        // Linear merge of what is left of both runs.
+        while (i < m && j < n) {
+            bool take_small = large_is_a ? L[j] > S[i] : !(L[j] < S[i]);
+            if (take_small) {
+                out.push(S[i++]);
+            } else {
+                std::size_t from = j++;
+                out.append(large, from, 1);
+            }
+        }
+    }
+
+    out.append(small, i, m - i);
+    out.append(large, j, n - j);
+}
+
+/*
+ * k-way external merge. The run with the smallest head (lowest run index on ties)
+ * gallops against the second smallest head: exponential probes of 1, 2, 4, ... 2^t
+ * elements find the whole range that can be written before any other run, which is
+ * then written as one bulk range.
+ */
+template <typename T>
+void external_merge_many(const std::vector<const MappedRun<T>*>& runs, RunFileWriter<T>& out) {
+    const std::size_t k = runs.size();
+    std::vector<std::size_t> pos(k, 0);
+
+    auto alive = [&](std::size_t r) { return pos[r] < runs[r]->size(); };
+    auto head  = [&](std::size_t r) -> const T& { return runs[r]->data()[pos[r]]; };
+
+    while (true) {
+        // Smallest and second smallest heads; earlier runs win ties.
+        std::size_t best = k, second = k;
+        for (std::size_t r = 0; r < k; ++r) {
+            if (!alive(r)) continue;
+            if (best == k || head(r) < head(best)) {
+                second = best;
+                best = r;
+            } else if (second == k || head(r) < head(second)) {
+                second = r;
+            }
+        }
+        if (best == k) break;
+
+        const T* data = runs[best]->data();
+        const std::size_t size = runs[best]->size();
+        std::size_t from = pos[best];
+
+        if (second == k) {
+            out.append(*runs[best], from, size - from);
+            pos[best] = size;
+            continue;
+        }
+
+        // Elements of `best` that go before the head of `second`.
+        const T& bound = head(second);
+        auto before = [&](const T& x) { return best < second ? !(bound < x) : x < bound; };
+
+        std::size_t lo = from + 1; // head(best) is known to go first
+        std::size_t step = 1;
+        while (lo + step - 1 < size && before(data[lo + step - 1])) {
+            lo += step;
+            step <<= 1;
+        }
+        std::size_t hi = std::min(lo + step - 1, size);
+        const T* end = best < second
+            ? std::upper_bound(data + lo, data + hi, bound)
+            : std::lower_bound(data + lo, data + hi, bound);
+
+        std::size_t to = static_cast<std::size_t>(end - data);
+        out.append(*runs[best], from, to - from);
+        pos[best] = to;
+    }
+}
+
+/*
+ * External merge of k >= 1 sorted run files into `output`.
+ *
+ * Parameters:
+ *   inputs       - paths of raw binary files, each a sorted array of T in native byte order.
+ *   output       - path of the merged file (created or truncated).
+ *   buffer_bytes - size of the write buffer for interleaved elements.
+ *   bulk_bytes   - ranges at least this long are copied file-to-file (default: 64 KiB).
+ *
+ * Returns:
+ *   ExternalMergeStats with the number of elements written and how much of it was bulk-copied.
+ *
+ * Notes:
+ *   - Two runs use the Hwang-Lin static block-skip test, more runs use galloping.
+ *   - The merge is stable: on equal keys earlier inputs come first.
+ */
+template <typename T>
+ExternalMergeStats external_merge(const std::vector<std::string>& inputs,
+                                  const std::string& output,
+                                  std::size_t buffer_bytes = std::size_t{1} << 20,
+                                  std::size_t bulk_bytes = std::size_t{1} << 16) {
+    std::vector<std::unique_ptr<MappedRun<T>>> runs;
+    std::vector<const MappedRun<T>*> views;
+    for (const auto& path : inputs) {
+        runs.push_back(std::make_unique<MappedRun<T>>(path));
+        views.push_back(runs.back().get());
+    }
+
+    ExternalMergeStats stats;
+    RunFileWriter<T> out(output, buffer_bytes, bulk_bytes, stats);
+
+    if (views.size() == 2) {
+        external_merge_two(*views[0], *views[1], out);
+    } else {
+        external_merge_many(views, out);
+    }
+    out.flush();
+
+    for (const auto* run : views) stats.elements += run->size();
+    return stats;
+}
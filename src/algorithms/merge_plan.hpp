@@ -0,0 +1,288 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Merge plans - compact run-length encoded descriptions of how two sorted
+ *              sequences interleave, together with appliers that replay a plan over payload columns.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "common.hpp"
+
+
+// Source of a run of output elements.
+enum class PlanSource : unsigned char { A, B };
+
+// A run of `count` consecutive output elements taken from one input, in input order.
+struct PlanSegment {
+    PlanSource  source;
+    std::size_t count;
+
+    bool operator==(const PlanSegment&) const = default;
+};
+
+/*
+ * MergePlan - run-length encoded list of (source, count) segments.
+ *
+ * A plan is computed once over the key columns and can then be applied to any
+ * number of payload columns. Each input is consumed strictly front to back, so a
+ * segment only needs the number of elements to take, not their positions.
+ * Adjacent segments from the same source are always coalesced.
+ */
+class MergePlan {
+public:
+    void append(PlanSource source, std::size_t count) {
+        if (count == 0) return;
+
+        if (!segments_.empty() && segments_.back().source == source) {
+            segments_.back().count += count;
+        } else {
+            segments_.push_back({source, count});
+        }
+
+        (source == PlanSource::A ? size_a_ : size_b_) += count;
+    }
+
+    // Plans built from the back of the inputs (Hwang-Lin static) are appended in
+    // reverse output order and flipped once at the end.
+    void reverse() {
+        std::reverse(segments_.begin(), segments_.end());
+    }
+
+    const std::vector<PlanSegment>& segments() const { return segments_; }
+    std::size_t size_a() const { return size_a_; }
+    std::size_t size_b() const { return size_b_; }
+    std::size_t size()   const { return size_a_ + size_b_; }
+    bool        empty()  const { return segments_.empty(); }
+
+    // Bitmap form of the plan: bit i is set when output element i comes from B.
+    std::vector<bool> to_bitmap() const {
+        std::vector<bool> bits;
+        bits.reserve(size());
+        for (const auto& seg : segments_) {
+            bits.insert(bits.end(), seg.count, seg.source == PlanSource::B);
+        }
+        return bits;
+    }
+
+    static MergePlan from_bitmap(const std::vector<bool>& bits) {
+        MergePlan plan;
+        for (bool from_b : bits) {
+            plan.append(from_b ? PlanSource::B : PlanSource::A, 1);
+        }
+        return plan;
+    }
+
+    bool operator==(const MergePlan&) const = default;
+
+private:
+    std::vector<PlanSegment> segments_;
+    std::size_t size_a_ = 0;
+    std::size_t size_b_ = 0;
+};
+
+
+/*
+ * Replays a plan: copies elements from the two inputs into `out` segment by segment.
+ * Every segment is a single bulk std::copy, so long runs (Hwang-Lin block skips)
+ * cost one memcpy for trivially copyable payloads.
+ *
+ * Returns the output iterator past the last written element.
+ */
+template <typename InIterA, typename InIterB, typename OutIter>
+OutIter apply_merge_plan(const MergePlan& plan, InIterA a_first, InIterB b_first, OutIter out) {
+    for (const auto& seg : plan.segments()) {
+        auto count = static_cast<typename std::iterator_traits<InIterA>::difference_type>(seg.count);
+        if (seg.source == PlanSource::A) {
+            out = std::copy(a_first, std::next(a_first, count), out);
+            std::advance(a_first, count);
+        } else {
+            out = std::copy(b_first, std::next(b_first, count), out);
+            std::advance(b_first, count);
+        }
+    }
+    return out;
+}
+
+// Applies a plan to one payload column, returning the permuted column.
+template <typename Column>
+Column apply_merge_plan(const MergePlan& plan, const Column& a, const Column& b) {
+    if (a.size() != plan.size_a() || b.size() != plan.size_b()) {
+        throw std::invalid_argument("apply_merge_plan: column sizes do not match the plan.");
+    }
+
+    Column out(plan.size());
+    apply_merge_plan(plan, a.begin(), b.begin(), out.begin());
+    return out;
+}
+
+// Applies a plan to any number of payload columns: a_columns[c] and b_columns[c] are
+// gathered into the c-th returned column.
+template <typename Column>
+std::vector<Column> apply_merge_plan_columns(const MergePlan& plan,
+                                             const std::vector<Column>& a_columns,
+                                             const std::vector<Column>& b_columns) {
+    if (a_columns.size() != b_columns.size()) {
+        throw std::invalid_argument("apply_merge_plan_columns: A and B have a different number of columns.");
+    }
+
+    std::vector<Column> out;
+    out.reserve(a_columns.size());
+    for (std::size_t c = 0; c < a_columns.size(); ++c) {
+        out.push_back(apply_merge_plan(plan, a_columns[c], b_columns[c]));
+    }
+    return out;
+}
+
+
+/*
+ * Builds a plan from an already merged sequence, given a projection that tells
+ * which input each element came from. Works for the output of any algorithm.
+ */
+template <typename IterContainer, typename SourceOf>
+MergePlan merge_plan_from_result(const IterContainer& merged, SourceOf source_of) {
+    MergePlan plan;
+    for (const auto& x : merged) {
+        plan.append(source_of(x), 1);
+    }
+    return plan;
+}
+
+// Key tagged with its source, ordered by the key only. Lets any merge algorithm
+// (including the in-place ones) report where each output element came from.
+template <typename T>
+struct PlanTagged {
+    T          key;
+    PlanSource source;
+
+    PlanTagged(const T& k = T(), PlanSource s = PlanSource::A) : key(k), source(s) {}
+
+    friend bool operator<(const PlanTagged& l, const PlanTagged& r)  { return l.key < r.key; }
+    friend bool operator>(const PlanTagged& l, const PlanTagged& r)  { return r.key < l.key; }
+    friend bool operator<=(const PlanTagged& l, const PlanTagged& r) { return !(r.key < l.key); }
+    friend bool operator>=(const PlanTagged& l, const PlanTagged& r) { return !(l.key < r.key); }
+    friend bool operator==(const PlanTagged& l, const PlanTagged& r) { return l.key == r.key; }
+    friend bool operator!=(const PlanTagged& l, const PlanTagged& r) { return !(l.key == r.key); }
+};
+
+/*
+ * Computes the plan of an arbitrary merge algorithm by running it over tagged keys.
+ *
+ * `merge_fn` receives two std::vector<PlanTagged<T>>& (which it may modify, like the
+ * in-place algorithms do) and returns the merged vector, e.g.
+ *   tagged_merge_plan(a, b, [](auto& x, auto& y) { return hwang_lin_dynamic_merge(x, y); });
+ */
+template <typename IterContainer, typename MergeFn>
+MergePlan tagged_merge_plan(const IterContainer& a, const IterContainer& b, MergeFn merge_fn) {
+    using value_t = typename IterContainer::value_type;
+
+    std::vector<PlanTagged<value_t>> ta;
+    std::vector<PlanTagged<value_t>> tb;
+    ta.reserve(a.size());
+    tb.reserve(b.size());
+    for (const auto& x : a) ta.emplace_back(x, PlanSource::A);
+    for (const auto& x : b) tb.emplace_back(x, PlanSource::B);
+
+    auto merged = merge_fn(ta, tb);
+    return merge_plan_from_result(merged, [](const auto& x) { return x.source; });
+}
+
+
+/*
+ * Two-way merge that emits a plan instead of merged values.
+ * Same comparisons and tie rule as two_way_merge (A first on equal keys).
+ */
+template <typename IterContainer>
+MergePlan two_way_merge_plan(const IterContainer& a, const IterContainer& b) {
+    MergePlan plan;
+    auto a_left = a.begin(), a_right = a.end();
+    auto b_left = b.begin(), b_right = b.end();
+
+    while (a_left != a_right && b_left != b_right) {
+        if (*a_left <= *b_left) {
+            plan.append(PlanSource::A, 1);
+            ++a_left;
+        } else {
+            plan.append(PlanSource::B, 1);
+            ++b_left;
+        }
+    }
+
+    plan.append(PlanSource::A, static_cast<std::size_t>(std::distance(a_left, a_right)));
+    plan.append(PlanSource::B, static_cast<std::size_t>(std::distance(b_left, b_right)));
+    return plan;
+}
+
+/*
+ * Hwang-Lin static merge that emits a plan instead of merged values.
+ *
+ * Mirrors hwang_lin_static_merge step by step (same comparisons, same tie rule),
+ * but never moves an element: a skipped 2^t block of the larger input becomes a
+ * single segment. The inputs are not modified.
+ */
+template <typename IterContainer>
+MergePlan hwang_lin_static_merge_plan(const IterContainer& a, const IterContainer& b) {
+    MergePlan plan;
+    if (a.empty() || b.empty()) {
+        plan.append(PlanSource::A, a.size());
+        plan.append(PlanSource::B, b.size());
+        return plan;
+    }
+
+    // The algorithm always inserts the smaller sequence into the larger one.
+    const bool swapped = a.size() > b.size();
+    const IterContainer& small = swapped ? b : a;
+    const IterContainer& large = swapped ? a : b;
+    const PlanSource small_src = swapped ? PlanSource::B : PlanSource::A;
+    const PlanSource large_src = swapped ? PlanSource::A : PlanSource::B;
+
+    int m = static_cast<int>(small.size());
+    int n = static_cast<int>(large.size());
+
+    int t = static_cast<int>(std::floor(std::log2(static_cast<double>(n) / m)));
+    int pow2t = pow2(t);
+
+    // Segments are produced from the back of the output.
+    while (m != 0 && n != 0) {
+        if (n < pow2t) {
+            break;
+        }
+
+        int k = n - pow2t;
+
+        if (small[m - 1] < large[k]) {
+            plan.append(large_src, static_cast<std::size_t>(pow2t));
+            n -= pow2t;
+            continue;
+        }
+
+        auto pos = std::upper_bound(large.begin() + k + 1, large.begin() + n, small[m - 1]);
+        plan.append(large_src, static_cast<std::size_t>(std::distance(pos, large.begin() + n)));
+        plan.append(small_src, 1);
+
+        n = static_cast<int>(std::distance(large.begin(), pos));
+        m--;
+    }
+
+    // Final reverse merge of the remaining prefixes.
+    while (m != 0 && n != 0) {
+        if (small[m - 1] >= large[n - 1]) {
+            plan.append(small_src, 1);
+            m--;
+        } else {
+            plan.append(large_src, 1);
+            n--;
+        }
+    }
+    plan.append(small_src, static_cast<std::size_t>(m));
+    plan.append(large_src, static_cast<std::size_t>(n));
+
+    plan.reverse();
+    return plan;
+}
@@ -0,0 +1,166 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Selection in the union of two sorted sequences: co-rank splits of the
+ *              stable merge for one rank or for many ranks at once, and the k-th element.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+
+// Split of the stable merge at rank k: its first k elements are a[0..i) and b[0..j), i + j = k.
+struct MergeSplit {
+    std::size_t i;
+    std::size_t j;
+
+    bool operator==(const MergeSplit&) const = default;
+};
+
+namespace merge_select_detail {
+
+/*
+ * Co-rank of k with i known to lie in [lo, hi]. i is too small while a[i] is not greater
+ * than b[k - i - 1], since a[i] then precedes b[k - i - 1] in the merge (a before b on
+ * equal elements). One comparison per halving of [lo, hi].
+ */
+template <typename RandomIt1, typename RandomIt2>
+std::size_t co_rank_in(RandomIt1 a_first, RandomIt2 b_first, std::size_t k, std::size_t lo, std::size_t hi) {
+    while (lo < hi) {
+        const std::size_t i = lo + (hi - lo) / 2;
+        if (!(b_first[k - i - 1] < a_first[i])) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Bounds of the co-rank of k from the sizes alone: [max(0, k - n), min(k, m)].
+inline std::size_t co_rank_low(std::size_t n, std::size_t k)  { return k > n ? k - n : 0; }
+inline std::size_t co_rank_high(std::size_t m, std::size_t k) { return std::min(k, m); }
+
+// Co-ranks of the sorted ranks ks[order[first..last)], all known to lie in [lo, hi].
+// The middle rank k is searched first (split i, j). A smaller rank k' has i' <= i and
+// j' <= j, a larger one i' >= i and j' >= j, so both halves recurse with bounds narrowed
+// around i; ranks equal to k get an empty interval and cost no comparison.
+template <typename RandomIt1, typename RandomIt2>
+void co_rank_batch(RandomIt1 a_first, RandomIt2 b_first, std::size_t m, std::size_t n,
+                   const std::vector<std::size_t>& ks, const std::vector<std::size_t>& order,
+                   std::size_t first, std::size_t last, std::size_t lo, std::size_t hi,
+                   std::vector<MergeSplit>& splits) {
+    if (first == last) return;
+    const std::size_t mid = first + (last - first) / 2;
+    const std::size_t k = ks[order[mid]];
+    const std::size_t i = co_rank_in(a_first, b_first, k,
+                                     std::max(lo, co_rank_low(n, k)), std::min(hi, co_rank_high(m, k)));
+    const std::size_t j = k - i;
+    splits[order[mid]] = {i, j};
+
+    const std::size_t k_first = ks[order[first]];
+    const std::size_t k_last  = ks[order[last - 1]];
+    co_rank_batch(a_first, b_first, m, n, ks, order, first, mid,
+                  std::max(lo, k_first > j ? k_first - j : 0), i, splits);
+    co_rank_batch(a_first, b_first, m, n, ks, order, mid + 1, last,
+                  i, std::min(hi, i + (k_last - k)), splits);
+}
+
+} // namespace merge_select_detail
+
+/*
+ * Algorithm: Co-rank (Merge Select)
+ *
+ * Implementation:
+ *   Developer: Igor Stikentzin
+ *
+ * Parameters:
+ *   RandomIt1 a_first, a_last - sorted sequence a (ascending).
+ *   RandomIt2 b_first, b_last - sorted sequence b (ascending).
+ *   std::size_t k             - rank; clamped to m + n.
+ *
+ * Return Value:
+ *   MergeSplit - (i, j) with i + j = k such that the first k elements of the stable merge
+ *                of a and b are a[0..i) and b[0..j).
+ *
+ * Notes:
+ *   - Ties follow hwang_lin_static_stable_merge: on equal elements a comes first, so the
+ *     split never takes b[j - 1] while leaving an a[i] that is not greater than it.
+ *   - Binary search over i in [max(0, k - n), min(k, m)]: at most
+ *     ceil(log2(min(m, n) + 1)) comparisons, no allocation.
+ */
+template <typename RandomIt1, typename RandomIt2>
+MergeSplit co_rank(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last, std::size_t k) {
+    const auto m = static_cast<std::size_t>(std::distance(a_first, a_last));
+    const auto n = static_cast<std::size_t>(std::distance(b_first, b_last));
+    k = std::min(k, m + n);
+    const std::size_t i = merge_select_detail::co_rank_in(a_first, b_first, k,
+        merge_select_detail::co_rank_low(n, k), merge_select_detail::co_rank_high(m, k));
+    return {i, k - i};
+}
+
+/*
+ * Batched co-rank: writes the split of every rank in [k_first, k_last) to out, in input
+ * order, and returns the end of the written range.
+ *
+ * Notes:
+ *   - The ranks are ordered once (O(q log q) on rank values, no element comparisons; none
+ *     if already sorted) and searched from the middle out, each search confined to the
+ *     bounds left by the searches of its neighbours. Evenly spread ranks then cost about
+ *     log2(min(m, n) / q) comparisons each instead of log2(min(m, n)).
+ */
+template <typename RandomIt1, typename RandomIt2, typename InputIt, typename OutputIt>
+OutputIt co_rank_batch(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last,
+                       InputIt k_first, InputIt k_last, OutputIt out) {
+    const auto m = static_cast<std::size_t>(std::distance(a_first, a_last));
+    const auto n = static_cast<std::size_t>(std::distance(b_first, b_last));
+
+    std::vector<std::size_t> ks;
+    for (; k_first != k_last; ++k_first) ks.push_back(std::min<std::size_t>(*k_first, m + n));
+
+    std::vector<std::size_t> order(ks.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    if (!std::is_sorted(ks.begin(), ks.end())) {
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) { return ks[x] < ks[y]; });
+    }
+
+    std::vector<MergeSplit> splits(ks.size());
+    merge_select_detail::co_rank_batch(a_first, b_first, m, n, ks, order, 0, ks.size(), 0, m, splits);
+    return std::copy(splits.begin(), splits.end(), out);
+}
+
+// Container front ends of co_rank and co_rank_batch.
+template <typename IterContainer>
+MergeSplit merge_select(const IterContainer& a, const IterContainer& b, std::size_t k) {
+    return co_rank(a.begin(), a.end(), b.begin(), b.end(), k);
+}
+
+template <typename IterContainer>
+std::vector<MergeSplit> merge_select(const IterContainer& a, const IterContainer& b, const std::vector<std::size_t>& ks) {
+    std::vector<MergeSplit> splits;
+    splits.reserve(ks.size());
+    co_rank_batch(a.begin(), a.end(), b.begin(), b.end(), ks.begin(), ks.end(), std::back_inserter(splits));
+    return splits;
+}
+
+/*
+ * k-th element (0-based) of the stable merge of a and b: the element that follows the
+ * split of rank k. One comparison more than merge_select.
+ * Throws std::out_of_range if k >= a.size() + b.size().
+ */
+template <typename IterContainer>
+const typename IterContainer::value_type& merge_nth(const IterContainer& a, const IterContainer& b, std::size_t k) {
+    if (k >= a.size() + b.size()) {
+        throw std::out_of_range("merge_nth: rank out of range");
+    }
+    const MergeSplit split = merge_select(a, b, k);
+    if (split.j == b.size() || (split.i < a.size() && !(b[split.j] < a[split.i]))) {
+        return a[split.i];
+    }
+    return b[split.j];
+}
@@ -0,0 +1,222 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Lazy stable merged view of two sorted ranges (views::merge), with a block-wise
+ *              for_each_block fast path that hands out runs found by Hwang-Lin block probes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+
+namespace merge_view_detail {
+
+// End of the prefix of [first, last) on which pred holds; pred(*first) is known to hold.
+// Probes the last element of blocks of `block` elements (Hwang-Lin) and doubles the block
+// after every block that is skipped whole, then binary searches the block that is not.
+// Blocks of up to 8 elements are scanned linearly, as in hwang_lin_knuth_merge.
+template <typename RandomIt, typename Pred>
+RandomIt run_end(RandomIt first, RandomIt last, std::size_t block, Pred pred) {
+    ++first;
+    while (true) {
+        const auto remaining = static_cast<std::size_t>(last - first);
+        if (block <= 8) {
+            auto stop = first + std::min(block, remaining);
+            for (; first != stop; ++first) {
+                if (!pred(*first)) return first;
+            }
+            if (remaining <= block) return first;
+        } else if (remaining < block) {
+            return std::partition_point(first, last, pred);
+        } else if (!pred(first[block - 1])) {
+            return std::partition_point(first, first + (block - 1), pred);
+        } else {
+            first += block;
+        }
+        block *= 2;
+    }
+}
+
+// Hwang-Lin block size 2^floor(log2(self / other)) for a run taken from the longer side.
+inline std::size_t block_size(std::size_t self, std::size_t other) {
+    return (other == 0 || self <= other) ? 1 : std::bit_floor(self / other);
+}
+
+} // namespace merge_view_detail
+
+/*
+ * Algorithm: Merged View
+ *
+ * Implementation:
+ *   Developer: Igor Stikentzin
+ *
+ * Parameters:
+ *   a, b - sorted views (ascending with respect to comp).
+ *   comp - strict weak ordering (default: std::ranges::less).
+ *
+ * Notes:
+ *   - Iterating the view yields the elements of a and b in merged order without
+ *     materializing the result. The merge is stable: if neither element is less than
+ *     the other, the one from a comes first. The iterator is a forward iterator; the
+ *     view ends at std::default_sentinel.
+ *   - for_each_block(fn) walks the same merge but calls fn(std::ranges::subrange) once per
+ *     maximal run taken from one side. Run ends are found with Hwang-Lin block probes
+ *     (block 2^floor(log2(|long| / |short|)), doubled after each block skipped whole),
+ *     so long runs cost a logarithmic number of comparisons and the consumer gets plain
+ *     contiguous loops over the runs, which the compiler can vectorize. It requires
+ *     random access ranges. When the inputs interleave closely (runs of one or two
+ *     elements) the per-run call costs more than it saves and plain iteration is faster.
+ *   - a and b are referenced, not copied (std::views::all), so they must outlive the view.
+ */
+template <std::ranges::view V1, std::ranges::view V2, typename Comp = std::ranges::less>
+requires std::ranges::forward_range<V1> && std::ranges::forward_range<V2>
+class merge_view : public std::ranges::view_interface<merge_view<V1, V2, Comp>> {
+public:
+    using reference = std::common_reference_t<std::ranges::range_reference_t<V1>,
+                                              std::ranges::range_reference_t<V2>>;
+    using value_type = std::remove_cvref_t<reference>;
+
+    class iterator {
+    public:
+        using iterator_concept  = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = merge_view::value_type;
+        using difference_type   = std::ptrdiff_t;
+
+        iterator() = default;
+
+        reference operator*() const {
+            if (from_b_) return *b_;
+            return *a_;
+        }
+
+        iterator& operator++() {
+            if (from_b_) ++b_;
+            else         ++a_;
+            select();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const iterator& x, const iterator& y) {
+            return x.a_ == y.a_ && x.b_ == y.b_;
+        }
+
+        friend bool operator==(const iterator& x, std::default_sentinel_t) {
+            return x.a_ == x.a_end_ && x.b_ == x.b_end_;
+        }
+
+    private:
+        friend class merge_view;
+
+        using It1 = std::ranges::iterator_t<V1>;
+        using It2 = std::ranges::iterator_t<V2>;
+        using End1 = std::ranges::sentinel_t<V1>;
+        using End2 = std::ranges::sentinel_t<V2>;
+
+        iterator(It1 a, End1 a_end, It2 b, End2 b_end, const Comp* comp)
+            : a_(std::move(a)), a_end_(std::move(a_end)), b_(std::move(b)), b_end_(std::move(b_end)), comp_(comp) {
+            select();
+        }
+
+        // The next element comes from b only if b's head is less than a's head.
+        void select() {
+            from_b_ = a_ == a_end_ || (b_ != b_end_ && std::invoke(*comp_, *b_, *a_));
+        }
+
+        It1         a_{};
+        End1        a_end_{};
+        It2         b_{};
+        End2        b_end_{};
+        const Comp* comp_ = nullptr;
+        bool        from_b_ = false;
+    };
+
+    merge_view() = default;
+
+    merge_view(V1 a, V2 b, Comp comp = {})
+        : a_(std::move(a)), b_(std::move(b)), comp_(std::move(comp)) {}
+
+    iterator begin() const {
+        return iterator(std::ranges::begin(a_), std::ranges::end(a_),
+                        std::ranges::begin(b_), std::ranges::end(b_), &comp_);
+    }
+
+    std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    auto size() const
+    requires std::ranges::sized_range<const V1> && std::ranges::sized_range<const V2> {
+        return std::ranges::size(a_) + std::ranges::size(b_);
+    }
+
+    // Calls fn(subrange) for every maximal run of the merge that comes from one side.
+    template <typename F>
+    void for_each_block(F&& fn) const
+    requires std::ranges::random_access_range<const V1> && std::ranges::common_range<const V1> &&
+             std::ranges::random_access_range<const V2> && std::ranges::common_range<const V2> {
+        auto a = std::ranges::begin(a_);
+        auto b = std::ranges::begin(b_);
+        const auto a_end = std::ranges::end(a_);
+        const auto b_end = std::ranges::end(b_);
+
+        // A maximal run ends where the other side's head goes first, so the sides alternate.
+        bool from_b = a != a_end && b != b_end && std::invoke(comp_, *b, *a);
+        while (a != a_end && b != b_end) {
+            const auto m = static_cast<std::size_t>(a_end - a);
+            const auto n = static_cast<std::size_t>(b_end - b);
+            if (from_b) {
+                const auto& head = *a;
+                auto stop = merge_view_detail::run_end(b, b_end, merge_view_detail::block_size(n, m),
+                    [&](const auto& x) { return std::invoke(comp_, x, head); });
+                fn(std::ranges::subrange(b, stop));
+                b = stop;
+            } else {
+                const auto& head = *b;
+                auto stop = merge_view_detail::run_end(a, a_end, merge_view_detail::block_size(m, n),
+                    [&](const auto& x) { return !std::invoke(comp_, head, x); });
+                fn(std::ranges::subrange(a, stop));
+                a = stop;
+            }
+            from_b = !from_b;
+        }
+        if (a != a_end) fn(std::ranges::subrange(a, a_end));
+        if (b != b_end) fn(std::ranges::subrange(b, b_end));
+    }
+
+    const V1& base_a() const { return a_; }
+    const V2& base_b() const { return b_; }
+
+private:
+    V1   a_{};
+    V2   b_{};
+    Comp comp_{};
+};
+
+template <typename R1, typename R2, typename Comp = std::ranges::less>
+merge_view(R1&&, R2&&, Comp = {}) -> merge_view<std::views::all_t<R1>, std::views::all_t<R2>, Comp>;
+
+namespace views {
+
+struct merge_fn {
+    template <std::ranges::viewable_range R1, std::ranges::viewable_range R2, typename Comp = std::ranges::less>
+    auto operator()(R1&& a, R2&& b, Comp comp = {}) const {
+        return merge_view(std::views::all(std::forward<R1>(a)), std::views::all(std::forward<R2>(b)), std::move(comp));
+    }
+};
+
+// views::merge(a, b[, comp]) - lazy stable merge of two sorted ranges.
+inline constexpr merge_fn merge{};
+
+} // namespace views
@@ -0,0 +1,191 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Uninitialized, aligned output storage for the out-of-place merges, optionally
+ *              backed by huge pages (hugetlbfs or transparent) and optionally pre-faulted.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+// Pages backing an OutputBuffer.
+enum class OutputPages {
+    Default,         // Ordinary heap allocation.
+    TransparentHuge, // Anonymous mapping aligned to 2 MB with madvise(MADV_HUGEPAGE).
+    ExplicitHuge     // MAP_HUGETLB; falls back to TransparentHuge if no huge pages are reserved.
+};
+
+struct OutputBufferOptions {
+    std::size_t alignment = 64;                // Power of two; raised to 2 MB for huge pages.
+    OutputPages pages     = OutputPages::Default;
+    bool        prefault  = false;             // Touch every page in the constructor.
+};
+
+/*
+ * Fixed-size output array of T that is never value-initialized.
+ *
+ * std::vector<T> r(m + n) zero-fills the output before the merge overwrites it, so every
+ * output byte is written twice and the first write also pays the page faults. The
+ * elements of an OutputBuffer are left uninitialized: the merge's own stores are the
+ * first ones and the page faults happen inside the merge, unless the buffer is
+ * pre-faulted, which moves them into the constructor (one byte written per page).
+ *
+ * data()/begin() are raw pointers, so every *_into merge can write to the buffer.
+ *
+ * Notes:
+ *   - T must be trivially copyable and trivially destructible: no constructors or
+ *     destructors are run for the elements.
+ *   - Reading an element before it was written yields an indeterminate value.
+ */
+template <typename T>
+class OutputBuffer {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "OutputBuffer leaves its elements uninitialized");
+
+public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    OutputBuffer() = default;
+
+    explicit OutputBuffer(std::size_t size, OutputBufferOptions options = {}) : size_(size), options_(options) {
+        if (options_.alignment == 0 || (options_.alignment & (options_.alignment - 1)) != 0) {
+            throw std::invalid_argument("OutputBuffer: alignment must be a power of two.");
+        }
+        options_.alignment = std::max(options_.alignment, alignof(T));
+        if (size_ == 0) return;
+
+        const std::size_t bytes = size_ * sizeof(T);
+        switch (options_.pages) {
+            case OutputPages::Default:
+                base_ = ::operator new(bytes, std::align_val_t(options_.alignment));
+                data_ = static_cast<T*>(base_);
+                break;
+            case OutputPages::ExplicitHuge:
+                if (mapHugeTlb(bytes)) break;
+                options_.pages = OutputPages::TransparentHuge;
+                [[fallthrough]];
+            case OutputPages::TransparentHuge:
+                mapTransparentHuge(bytes);
+                break;
+        }
+
+        if (options.prefault) prefault();
+    }
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    OutputBuffer(OutputBuffer&& other) noexcept { swap(other); }
+
+    OutputBuffer& operator=(OutputBuffer&& other) noexcept {
+        OutputBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~OutputBuffer() {
+        if (!base_) return;
+        if (options_.pages == OutputPages::Default) {
+            ::operator delete(base_, std::align_val_t(options_.alignment));
+        } else {
+            ::munmap(base_, mapped_);
+        }
+    }
+
+    void swap(OutputBuffer& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(base_, other.base_);
+        std::swap(mapped_, other.mapped_);
+        std::swap(options_, other.options_);
+    }
+
+    // Writes one byte per page so that all page faults happen now, not in the merge.
+    // Transparent huge pages are not guaranteed, so only hugetlb pages are skipped at 2 MB.
+    void prefault() {
+        const std::size_t page = options_.pages == OutputPages::ExplicitHuge
+            ? kHugePageSize
+            : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        auto* bytes = reinterpret_cast<volatile unsigned char*>(data_);
+        const std::size_t total = size_ * sizeof(T);
+        for (std::size_t offset = 0; offset < total; offset += page) bytes[offset] = 0;
+        if (total > 0) bytes[total - 1] = 0;
+    }
+
+    T*          data()       { return data_; }
+    const T*    data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool        empty() const { return size_ == 0; }
+
+    T*       begin()       { return data_; }
+    T*       end()         { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end()   const { return data_ + size_; }
+
+    T&       operator[](std::size_t i)       { return data_[i]; }
+    const T& operator[](std::size_t i) const { return data_[i]; }
+
+    std::span<T>       span()       { return {data_, size_}; }
+    std::span<const T> span() const { return {data_, size_}; }
+
+    // Pages actually used: ExplicitHuge turns into TransparentHuge when MAP_HUGETLB fails.
+    OutputPages pages()     const { return options_.pages; }
+    std::size_t alignment() const { return options_.alignment; }
+
+private:
+    static std::size_t roundUp(std::size_t bytes, std::size_t unit) {
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    bool mapHugeTlb(std::size_t bytes) {
+        mapped_ = roundUp(bytes, kHugePageSize);
+        void* p = ::mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) return false;
+        base_ = p;
+        data_ = static_cast<T*>(p);
+        options_.alignment = std::max(options_.alignment, kHugePageSize);
+        return true;
+    }
+
+    // Over-maps by one alignment unit and unmaps the unaligned head and tail.
+    void mapTransparentHuge(std::size_t bytes) {
+        const std::size_t alignment = std::max(options_.alignment, kHugePageSize);
+        const std::size_t length = roundUp(bytes, kHugePageSize);
+        void* p = ::mmap(nullptr, length + alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error(std::string("OutputBuffer: unable to map memory: ") + std::strerror(errno));
+        }
+
+        auto start = reinterpret_cast<std::uintptr_t>(p);
+        auto aligned = (start + alignment - 1) / alignment * alignment;
+        if (aligned > start) ::munmap(p, aligned - start);
+        if (std::size_t tail = start + length + alignment - (aligned + length)) {
+            ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+        }
+
+        base_ = reinterpret_cast<void*>(aligned);
+        mapped_ = length;
+        data_ = static_cast<T*>(base_);
+        options_.alignment = alignment;
+        ::madvise(base_, mapped_, MADV_HUGEPAGE);
+    }
+
+    T*                  data_ = nullptr;
+    std::size_t         size_ = 0;
+    void*               base_ = nullptr;
+    std::size_t         mapped_ = 0;
+    OutputBufferOptions options_;
+};
@@ -0,0 +1,165 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Parallel stable merges on the work-stealing scheduler: in-place SymMerge and
+ *              SplitMerge, and fractile insertion into a preallocated output.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include "algorithms.hpp"
+#include "work_stealing.hpp"
+
+
+namespace parallel_merge_detail {
+
+// Recurses through `split` in parallel until a subproblem has at most `grain`
+// elements, which is then merged sequentially by `sequential`.
+template <typename It, typename Split, typename Sequential>
+void recurse(WorkStealingScheduler& scheduler, MergeRange<It> range, std::ptrdiff_t grain,
+             Split split, Sequential sequential) {
+    if (range.empty()) return;
+    if (std::distance(range.first, range.last) <= grain) {
+        sequential(range.first, range.separator, range.last);
+        return;
+    }
+
+    auto [left, right] = split(range.first, range.separator, range.last);
+    scheduler.fork_join(
+        [&] { recurse(scheduler, left, grain, split, sequential); },
+        [&] { recurse(scheduler, right, grain, split, sequential); });
+}
+
+} // namespace parallel_merge_detail
+
+/*
+ * Algorithm: Parallel SymMerge
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   scheduler - work-stealing scheduler that runs the recursion.
+ *   begin, separator, end - [begin, separator) and [separator, end) are sorted ranges.
+ *   grain     - subproblems of at most this many elements are merged sequentially (default: 16K).
+ *
+ * Notes:
+ *   - The split step is the one of simple_kim_kutzner_alg; the two subproblems it leaves
+ *     are disjoint, so they are forked. The result is identical to simple_kim_kutzner_alg:
+ *     stable and in place, without any buffer.
+ */
+template <typename RandomIt>
+void parallel_simple_kim_kutzner_alg(WorkStealingScheduler& scheduler,
+                                     RandomIt begin, RandomIt separator, RandomIt end,
+                                     std::ptrdiff_t grain = std::ptrdiff_t{1} << 14) {
+    scheduler.run([&] {
+        parallel_merge_detail::recurse(scheduler, MergeRange<RandomIt>{begin, separator, end}, grain,
+            [](RandomIt f, RandomIt s, RandomIt l) { return simple_kim_kutzner_split(f, s, l); },
+            [](RandomIt f, RandomIt s, RandomIt l) { simple_kim_kutzner_alg(f, s, l); });
+    });
+}
+
+/*
+ * Algorithm: Parallel SplitMerge
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   scheduler - work-stealing scheduler that runs the recursion.
+ *   first1, first2, last - [first1, first2) and [first2, last) are sorted ranges.
+ *   grain     - subproblems of at most this many elements are merged sequentially (default: 16K).
+ *
+ * Notes:
+ *   - Forks the two subproblems left by split_merge_split. The result is identical to
+ *     split_merge_alg: stable and in place, without any buffer.
+ */
+template <typename RandomIt>
+void parallel_split_merge_alg(WorkStealingScheduler& scheduler,
+                              RandomIt first1, RandomIt first2, RandomIt last,
+                              std::ptrdiff_t grain = std::ptrdiff_t{1} << 14) {
+    scheduler.run([&] {
+        parallel_merge_detail::recurse(scheduler, MergeRange<RandomIt>{first1, first2, last}, grain,
+            [](RandomIt f, RandomIt s, RandomIt l) { return split_merge_split(f, s, l); },
+            [](RandomIt f, RandomIt s, RandomIt l) { split_merge_alg(f, s, l); });
+    });
+}
+
+/*
+ * Algorithm: Parallel Fractile Insertion
+ *
+ * Implementation:
+ *   Developer: Igor Stikentzin
+ *
+ * Parameters:
+ *   scheduler - work-stealing scheduler that runs the recursion.
+ *   a_first, a_last, b_first, b_last - sorted input ranges.
+ *   out       - preallocated output of |A| + |B| elements (must not overlap the inputs).
+ *   grain     - subproblems of at most this many elements are not forked (default: 16K).
+ *
+ * Return Value:
+ *   OutputIt - end of the written range.
+ *
+ * Notes:
+ *   - Each pivot of A is placed by Tanner's probes into its final output position; the
+ *     two subproblems it leaves write disjoint parts of out and are forked as tasks.
+ *   - Same result and comparison count as fractile_insertion_merge_into: stable in
+ *     both orientations.
+ */
+template <typename InputIt, typename OutputIt>
+OutputIt parallel_fractile_insertion_merge_into(WorkStealingScheduler& scheduler,
+                                                InputIt a_first, InputIt a_last,
+                                                InputIt b_first, InputIt b_last, OutputIt out,
+                                                std::size_t grain = std::size_t{1} << 14) {
+    const int m = static_cast<int>(std::distance(a_first, a_last));
+    const int n = static_cast<int>(std::distance(b_first, b_last));
+
+    scheduler.run([&] {
+        auto fork = [&](auto&& left, auto&& right, std::size_t size) {
+            if (size > grain) {
+                scheduler.fork_join(left, right);
+            } else {
+                left();
+                right();
+            }
+        };
+        if (m <= n) {
+            fractile_insertion_into_alg(a_first, m, b_first, n, out, true, fork);
+        } else {
+            fractile_insertion_into_alg(b_first, n, a_first, m, out, false, fork);
+        }
+    });
+    return out + (m + n);
+}
+
+// Container front ends, same contract as simple_kim_kutzner_merge and split_merge.
+template <typename IterContainer>
+IterContainer parallel_simple_kim_kutzner_merge(WorkStealingScheduler& scheduler, IterContainer& a, IterContainer& b) {
+    auto orig_a_size = a.size();
+    a.insert(a.end(),
+                std::make_move_iterator(b.begin()),
+                std::make_move_iterator(b.end()));
+    b.clear();
+    parallel_simple_kim_kutzner_alg(scheduler, a.begin(), std::next(a.begin(), orig_a_size), a.end());
+    return a;
+}
+
+template <typename IterContainer>
+IterContainer parallel_split_merge(WorkStealingScheduler& scheduler, IterContainer& a, IterContainer& b) {
+    auto a_size = a.size();
+    a.insert(a.end(),
+                std::make_move_iterator(b.begin()),
+                std::make_move_iterator(b.end()));
+    parallel_split_merge_alg(scheduler, a.begin(), std::next(a.begin(), a_size), a.end());
+    return a;
+}
+
+template <typename IterContainer>
+IterContainer parallel_fractile_insertion_merge(WorkStealingScheduler& scheduler,
+                                                const IterContainer& a, const IterContainer& b) {
+    IterContainer r(a.size() + b.size());
+    parallel_fractile_insertion_merge_into(scheduler, a.begin(), a.end(), b.begin(), b.end(), r.begin());
+    return r;
+}
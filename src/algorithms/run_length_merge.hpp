@@ -0,0 +1,91 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Run-length-aware merge for inputs with long runs of equal keys: every run
+ *              is located by exponential search and copied in one piece.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+
+namespace run_length_merge_detail {
+
+// End of the prefix of [first, last) on which pred holds; pred(*first) is known to hold.
+// Probes first[1], first[2], first[4], ... until pred fails, then binary searches the
+// last gap: 2 * log2(run) + 1 comparisons for a run of `run` elements, one for a run of one.
+template <typename RandomIt, typename Pred>
+RandomIt gallop_end(RandomIt first, RandomIt last, Pred pred) {
+    const auto size = static_cast<std::size_t>(std::distance(first, last));
+    std::size_t known = 0;   // pred(first[known]) holds.
+    std::size_t probe = 1;
+    while (probe < size && pred(first[probe])) {
+        known = probe;
+        probe *= 2;
+    }
+    return std::partition_point(first + (known + 1), first + std::min(probe, size), pred);
+}
+
+} // namespace run_length_merge_detail
+
+// Iterator core of run_length_merge: writes the merge of [a_first, a_last) and
+// [b_first, b_last) to out (front to back) and returns the end of the written range.
+template <typename RandomIt1, typename RandomIt2, typename OutputIt>
+OutputIt run_length_merge_into(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last, OutputIt out) {
+    if (a_first == a_last) return std::copy(b_first, b_last, out);
+    if (b_first == b_last) return std::copy(a_first, a_last, out);
+
+    // A run ends where the other side's head goes first, so after the first comparison
+    // the sides simply alternate.
+    bool from_a = !(*b_first < *a_first);
+    while (a_first != a_last && b_first != b_last) {
+        if (from_a) {
+            // Elements of a equal to b's head go before it.
+            const auto& head = *b_first;
+            auto stop = run_length_merge_detail::gallop_end(a_first, a_last, [&](const auto& x) { return !(head < x); });
+            out = std::copy(a_first, stop, out);
+            a_first = stop;
+        } else {
+            // Elements of b equal to a's head go after it.
+            const auto& head = *a_first;
+            auto stop = run_length_merge_detail::gallop_end(b_first, b_last, [&](const auto& x) { return x < head; });
+            out = std::copy(b_first, stop, out);
+            b_first = stop;
+        }
+        from_a = !from_a;
+    }
+    out = std::copy(a_first, a_last, out);
+    return std::copy(b_first, b_last, out);
+}
+
+/*
+ * Algorithm: Run-Length-Aware Merge
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   const IterContainer& a - container with a sorted sequence. Elements must be in ascending order.
+ *   const IterContainer& b - container with a sorted sequence. Elements must be in ascending order.
+ *
+ * Return Value:
+ *   IterContainer - merged container of size a.size() + b.size(), sorted ascending; stable
+ *                   (if a[i] == b[j], the element from a comes first).
+ *
+ * Notes:
+ *   - The output is a sequence of maximal runs taken alternately from a and b: the run of
+ *     a up to and including the elements equal to b's head, then the run of b below a's
+ *     new head, and so on. Each run end is found by exponential search from the run start
+ *     and the run is copied with one std::copy.
+ *   - With d distinct keys the output has at most 2d runs, so the merge costs
+ *     O(d log((m + n) / d)) comparisons instead of m + n - 1. When the inputs interleave
+ *     element by element it needs about one comparison per element, as two_way_merge.
+ */
+template <typename IterContainer>
+IterContainer run_length_merge(const IterContainer& a, const IterContainer& b) {
+    IterContainer result(a.size() + b.size());
+    run_length_merge_into(a.begin(), a.end(), b.begin(), b.end(), result.begin());
+    return result;
+}
@@ -0,0 +1,74 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Struct-of-arrays merge front end: compares only over the key column and
+ *              moves payload columns afterwards with bulk copies driven by a merge plan.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "merge_plan.hpp"
+
+
+// Column-wise table: one sorted key column and any number of payload columns of equal length.
+template <typename Key, typename Payload>
+struct SoaTable {
+    std::vector<Key>                  keys;
+    std::vector<std::vector<Payload>> columns;
+
+    std::size_t size() const { return keys.size(); }
+};
+
+/*
+ * Merges two column-wise tables.
+ *
+ * Phase 1 runs `plan_fn(a.keys, b.keys)` over the contiguous key arrays only and
+ * produces a MergePlan; phase 2 replays the plan over the key column and every
+ * payload column, one bulk copy per segment. Payloads never take part in comparisons.
+ *
+ * `plan_fn` is any callable returning a MergePlan, e.g. two_way_merge_plan,
+ * hwang_lin_static_merge_plan, or one of the soa_*_plan helpers below.
+ */
+template <typename Key, typename Payload, typename PlanFn>
+SoaTable<Key, Payload> soa_merge(const SoaTable<Key, Payload>& a,
+                                 const SoaTable<Key, Payload>& b,
+                                 PlanFn plan_fn) {
+    if (a.columns.size() != b.columns.size()) {
+        throw std::invalid_argument("soa_merge: A and B have a different number of payload columns.");
+    }
+
+    MergePlan plan = plan_fn(a.keys, b.keys);
+
+    SoaTable<Key, Payload> out;
+    out.keys    = apply_merge_plan(plan, a.keys, b.keys);
+    out.columns = apply_merge_plan_columns(plan, a.columns, b.columns);
+    return out;
+}
+
+
+// Plan helpers for algorithms without a native plan builder. The keys are tagged
+// with their source (one extra byte per key) and merged by the algorithm itself.
+
+template <typename KeyContainer>
+MergePlan soa_hwang_lin_dynamic_plan(const KeyContainer& a, const KeyContainer& b) {
+    return tagged_merge_plan(a, b, [](auto& x, auto& y) { return hwang_lin_dynamic_merge(x, y); });
+}
+
+template <typename KeyContainer>
+MergePlan soa_hwang_lin_static_kutzner_plan(const KeyContainer& a, const KeyContainer& b) {
+    return tagged_merge_plan(a, b, [](auto& x, auto& y) { return hwang_lin_static_kutzner_merge(x, y); });
+}
+
+template <typename KeyContainer>
+MergePlan soa_simple_kim_kutzner_plan(const KeyContainer& a, const KeyContainer& b) {
+    return tagged_merge_plan(a, b, [](auto& x, auto& y) { return simple_kim_kutzner_merge(x, y); });
+}
+
+template <typename KeyContainer>
+MergePlan soa_unstable_core_kim_kutzner_plan(const KeyContainer& a, const KeyContainer& b) {
+    return tagged_merge_plan(a, b, [](auto& x, auto& y) { return unstable_core_kim_kutzner_merge(x, y); });
+}
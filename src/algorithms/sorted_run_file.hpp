@@ -0,0 +1,490 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Binary file format for sorted runs (header, fixed-width or delta/varint blocks,
+ *              sparse min/max block index), its writer and reader, and a merge of two run
+ *              files that skips whole blocks through the index without decoding them.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "streaming_merge.hpp"
+
+
+/*
+ * File layout (native byte order):
+ *
+ *   [header, 64 bytes]
+ *     magic "EMARUN01", version, element type, encoding, stability tag,
+ *     block size, element count, block count, index offset
+ *   [block 0][block 1]...[block k-1]
+ *     each block holds up to `block size` elements, encoded on its own
+ *   [index: k entries of 40 bytes]
+ *     offset and byte length of the block, element count, min key, max key
+ *
+ * Every block is self-contained (a delta block starts from an absolute value),
+ * so a block can be copied byte for byte into another run file of the same
+ * element type and encoding.
+ */
+
+enum class RunElementType : std::uint8_t { Int32 = 1, Int64 = 2, UInt32 = 3, UInt64 = 4, Float64 = 5 };
+
+enum class RunEncoding : std::uint8_t {
+    Fixed       = 0, // Raw fixed-width values.
+    DeltaVarint = 1  // First value zigzag-varint, then varint gaps to the previous value (integers only).
+};
+
+enum class RunStability : std::uint8_t {
+    Unknown  = 0,
+    Stable   = 1, // Equal keys appear in the order of their sources (e.g. output of a stable merge).
+    Unstable = 2
+};
+
+template <typename T> struct RunElementTraits;
+template <> struct RunElementTraits<std::int32_t>  { static constexpr RunElementType type = RunElementType::Int32; };
+template <> struct RunElementTraits<std::int64_t>  { static constexpr RunElementType type = RunElementType::Int64; };
+template <> struct RunElementTraits<std::uint32_t> { static constexpr RunElementType type = RunElementType::UInt32; };
+template <> struct RunElementTraits<std::uint64_t> { static constexpr RunElementType type = RunElementType::UInt64; };
+template <> struct RunElementTraits<double>        { static constexpr RunElementType type = RunElementType::Float64; };
+
+// One entry of the sparse skip index.
+template <typename T>
+struct RunBlock {
+    std::uint64_t offset = 0; // Byte offset of the encoded block in the file.
+    std::uint64_t bytes  = 0; // Encoded length.
+    std::uint32_t count  = 0; // Number of elements.
+    T             min{};      // First (smallest) key of the block.
+    T             max{};      // Last (largest) key of the block.
+};
+
+namespace run_file_detail {
+
+constexpr char          kMagic[8]    = {'E', 'M', 'A', 'R', 'U', 'N', '0', '1'};
+constexpr std::uint32_t kVersion     = 1;
+constexpr std::size_t   kHeaderBytes = 64;
+constexpr std::size_t   kIndexBytes  = 40;
+
+template <typename V>
+void put(unsigned char* dst, const V& v) { std::memcpy(dst, &v, sizeof(V)); }
+
+template <typename V>
+V get(const unsigned char* src) { V v; std::memcpy(&v, src, sizeof(V)); return v; }
+
+inline void put_varint(std::vector<unsigned char>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<unsigned char>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+inline std::uint64_t get_varint(const unsigned char*& p, const unsigned char* end) {
+    std::uint64_t v = 0;
+    for (int shift = 0; p != end && shift < 64; shift += 7) {
+        unsigned char byte = *p++;
+        v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    throw std::runtime_error("sorted run file: truncated varint.");
+}
+
+template <typename T>
+std::uint64_t zigzag(T v) {
+    auto x = static_cast<std::int64_t>(v);
+    return (static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63);
+}
+
+template <typename T>
+T unzigzag(std::uint64_t v) {
+    return static_cast<T>(static_cast<std::int64_t>((v >> 1) ^ (~(v & 1) + 1)));
+}
+
+template <typename T>
+void encode_block(const T* values, std::size_t count, RunEncoding encoding, std::vector<unsigned char>& out) {
+    out.clear();
+    if (encoding == RunEncoding::Fixed) {
+        out.resize(count * sizeof(T));
+        std::memcpy(out.data(), values, out.size());
+        return;
+    }
+    if constexpr (std::is_integral_v<T>) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i == 0) {
+                put_varint(out, std::is_signed_v<T> ? zigzag(values[0]) : static_cast<std::uint64_t>(values[0]));
+            } else {
+                put_varint(out, static_cast<std::uint64_t>(values[i]) - static_cast<std::uint64_t>(values[i - 1]));
+            }
+        }
+    }
+}
+
+template <typename T>
+void decode_block(const unsigned char* data, std::size_t bytes, std::size_t count,
+                  RunEncoding encoding, std::vector<T>& out) {
+    out.resize(count);
+    if (encoding == RunEncoding::Fixed) {
+        if (bytes != count * sizeof(T)) throw std::runtime_error("sorted run file: corrupt fixed-width block.");
+        std::memcpy(out.data(), data, bytes);
+        return;
+    }
+    if constexpr (std::is_integral_v<T>) {
+        const unsigned char* p = data;
+        const unsigned char* end = data + bytes;
+        std::uint64_t prev = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            std::uint64_t v = get_varint(p, end);
+            if (i == 0) {
+                prev = std::is_signed_v<T> ? static_cast<std::uint64_t>(unzigzag<T>(v)) : v;
+            } else {
+                prev += v;
+            }
+            out[i] = static_cast<T>(prev);
+        }
+    } else {
+        throw std::runtime_error("sorted run file: delta/varint block for a non-integral element type.");
+    }
+}
+
+} // namespace run_file_detail
+
+
+/*
+ * Writes a sorted run file.
+ *
+ * Values are pushed in non-decreasing order and grouped into blocks of
+ * `block_size` elements. append_encoded_block() copies an already encoded block
+ * from another file (same element type and encoding) without decoding it.
+ * close() writes the index and the final header; the destructor calls it too.
+ */
+template <typename T>
+class SortedRunWriter {
+public:
+    SortedRunWriter(const std::string& path,
+                    RunEncoding encoding = RunEncoding::DeltaVarint,
+                    std::uint32_t block_size = 4096,
+                    RunStability stability = RunStability::Unknown)
+        : out_(path, std::ios::binary | std::ios::trunc),
+          encoding_(encoding), block_size_(std::max<std::uint32_t>(block_size, 1)), stability_(stability) {
+        if (!out_.is_open()) {
+            throw std::runtime_error("SortedRunWriter: unable to open " + path);
+        }
+        if (encoding_ == RunEncoding::DeltaVarint && !std::is_integral_v<T>) {
+            throw std::invalid_argument("SortedRunWriter: delta/varint encoding requires an integral element type.");
+        }
+        pending_.reserve(block_size_);
+        write_header(); // placeholder, rewritten by close()
+    }
+
+    SortedRunWriter(const SortedRunWriter&) = delete;
+    SortedRunWriter& operator=(const SortedRunWriter&) = delete;
+
+    ~SortedRunWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    void push(const T& value) {
+        pending_.push_back(value);
+        if (pending_.size() == block_size_) flush_block();
+    }
+
+    template <typename It>
+    void push(It first, It last) {
+        for (; first != last; ++first) push(*first);
+    }
+
+    // Appends a block encoded with the same element type and encoding.
+    void append_encoded_block(const RunBlock<T>& block, const std::vector<unsigned char>& bytes) {
+        flush_block();
+        RunBlock<T> entry = block;
+        entry.offset = position_;
+        out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        position_ += bytes.size();
+        count_ += entry.count;
+        index_.push_back(entry);
+    }
+
+    RunEncoding encoding() const { return encoding_; }
+
+    void close() {
+        if (closed_) return;
+        flush_block();
+
+        const std::uint64_t index_offset = position_;
+        for (const auto& block : index_) {
+            unsigned char entry[run_file_detail::kIndexBytes] = {};
+            run_file_detail::put(entry + 0, block.offset);
+            run_file_detail::put(entry + 8, block.bytes);
+            run_file_detail::put(entry + 16, block.count);
+            run_file_detail::put(entry + 24, block.min);
+            run_file_detail::put(entry + 32, block.max);
+            out_.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        }
+
+        out_.seekp(0);
+        write_header(index_offset);
+        out_.close();
+        closed_ = true;
+    }
+
+private:
+    void flush_block() {
+        if (pending_.empty()) return;
+        run_file_detail::encode_block(pending_.data(), pending_.size(), encoding_, scratch_);
+
+        RunBlock<T> block;
+        block.offset = position_;
+        block.bytes  = scratch_.size();
+        block.count  = static_cast<std::uint32_t>(pending_.size());
+        block.min    = pending_.front();
+        block.max    = pending_.back();
+        index_.push_back(block);
+
+        out_.write(reinterpret_cast<const char*>(scratch_.data()), static_cast<std::streamsize>(scratch_.size()));
+        position_ += scratch_.size();
+        count_ += pending_.size();
+        pending_.clear();
+    }
+
+    void write_header(std::uint64_t index_offset = 0) {
+        unsigned char header[run_file_detail::kHeaderBytes] = {};
+        std::memcpy(header, run_file_detail::kMagic, sizeof(run_file_detail::kMagic));
+        run_file_detail::put(header + 8, run_file_detail::kVersion);
+        header[12] = static_cast<unsigned char>(RunElementTraits<T>::type);
+        header[13] = static_cast<unsigned char>(encoding_);
+        header[14] = static_cast<unsigned char>(stability_);
+        run_file_detail::put(header + 16, block_size_);
+        run_file_detail::put(header + 24, count_);
+        run_file_detail::put(header + 32, static_cast<std::uint64_t>(index_.size()));
+        run_file_detail::put(header + 40, index_offset);
+        out_.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    std::ofstream               out_;
+    RunEncoding                 encoding_;
+    std::uint32_t               block_size_;
+    RunStability                stability_;
+    std::vector<T>              pending_;
+    std::vector<unsigned char>  scratch_;
+    std::vector<RunBlock<T>>    index_;
+    std::uint64_t               position_ = run_file_detail::kHeaderBytes;
+    std::uint64_t               count_ = 0;
+    bool                        closed_ = false;
+};
+
+/*
+ * Reads a sorted run file. The header and the whole sparse index are loaded on
+ * open; blocks are read (and decoded) only on request.
+ */
+template <typename T>
+class SortedRunReader {
+public:
+    explicit SortedRunReader(const std::string& path) : in_(path, std::ios::binary) {
+        if (!in_.is_open()) {
+            throw std::runtime_error("SortedRunReader: unable to open " + path);
+        }
+
+        unsigned char header[run_file_detail::kHeaderBytes];
+        if (!in_.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+            std::memcmp(header, run_file_detail::kMagic, sizeof(run_file_detail::kMagic)) != 0) {
+            throw std::runtime_error("SortedRunReader: " + path + " is not a sorted run file.");
+        }
+        if (run_file_detail::get<std::uint32_t>(header + 8) != run_file_detail::kVersion) {
+            throw std::runtime_error("SortedRunReader: unsupported version in " + path);
+        }
+        if (static_cast<RunElementType>(header[12]) != RunElementTraits<T>::type) {
+            throw std::runtime_error("SortedRunReader: element type of " + path + " does not match.");
+        }
+
+        encoding_   = static_cast<RunEncoding>(header[13]);
+        stability_  = static_cast<RunStability>(header[14]);
+        block_size_ = run_file_detail::get<std::uint32_t>(header + 16);
+        count_      = run_file_detail::get<std::uint64_t>(header + 24);
+
+        auto blocks       = run_file_detail::get<std::uint64_t>(header + 32);
+        auto index_offset = run_file_detail::get<std::uint64_t>(header + 40);
+
+        in_.seekg(static_cast<std::streamoff>(index_offset));
+        index_.resize(blocks);
+        for (auto& block : index_) {
+            unsigned char entry[run_file_detail::kIndexBytes];
+            if (!in_.read(reinterpret_cast<char*>(entry), sizeof(entry))) {
+                throw std::runtime_error("SortedRunReader: truncated index in " + path);
+            }
+            block.offset = run_file_detail::get<std::uint64_t>(entry + 0);
+            block.bytes  = run_file_detail::get<std::uint64_t>(entry + 8);
+            block.count  = run_file_detail::get<std::uint32_t>(entry + 16);
+            block.min    = run_file_detail::get<T>(entry + 24);
+            block.max    = run_file_detail::get<T>(entry + 32);
+        }
+    }
+
+    std::uint64_t        size()        const { return count_; }
+    std::size_t          block_count() const { return index_.size(); }
+    std::uint32_t        block_size()  const { return block_size_; }
+    RunEncoding          encoding()    const { return encoding_; }
+    RunStability         stability()   const { return stability_; }
+    const RunBlock<T>&   block(std::size_t i) const { return index_[i]; }
+
+    // Reads the encoded bytes of block i.
+    void read_raw_block(std::size_t i, std::vector<unsigned char>& bytes) {
+        bytes.resize(index_[i].bytes);
+        in_.seekg(static_cast<std::streamoff>(index_[i].offset));
+        if (!in_.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            throw std::runtime_error("SortedRunReader: truncated block.");
+        }
+    }
+
+    // Reads and decodes block i.
+    void read_block(std::size_t i, std::vector<T>& values) {
+        read_raw_block(i, scratch_);
+        run_file_detail::decode_block(scratch_.data(), scratch_.size(), index_[i].count, encoding_, values);
+    }
+
+    std::vector<T> read_all() {
+        std::vector<T> all;
+        all.reserve(count_);
+        std::vector<T> values;
+        for (std::size_t i = 0; i < index_.size(); ++i) {
+            read_block(i, values);
+            all.insert(all.end(), values.begin(), values.end());
+        }
+        return all;
+    }
+
+private:
+    std::ifstream              in_;
+    RunEncoding                encoding_ = RunEncoding::Fixed;
+    RunStability               stability_ = RunStability::Unknown;
+    std::uint32_t              block_size_ = 0;
+    std::uint64_t              count_ = 0;
+    std::vector<RunBlock<T>>   index_;
+    std::vector<unsigned char> scratch_;
+};
+
+// Serves a sorted run file block by block to StreamingMerge.
+template <typename T>
+class SortedRunChunkSource : public ChunkSource<T> {
+public:
+    explicit SortedRunChunkSource(const std::string& path) : reader_(path) {}
+
+    StreamInputChunk<T> next() override {
+        if (next_block_ >= reader_.block_count()) return nullptr;
+        auto chunk = std::make_shared<std::vector<T>>();
+        reader_.read_block(next_block_++, *chunk);
+        return chunk;
+    }
+
+private:
+    SortedRunReader<T> reader_;
+    std::size_t        next_block_ = 0;
+};
+
+
+// Counters of a merge over run files.
+struct RunFileMergeStats {
+    std::size_t blocks_copied  = 0; // Blocks passed through encoded, never decoded.
+    std::size_t blocks_decoded = 0;
+};
+
+/*
+ * Merges two sorted run files into `out` using their skip indices.
+ *
+ * Before a block is decoded, its max key from the index is compared with the head
+ * of the other side (its decoded head, or the min key of its next block). A block
+ * that entirely precedes the other side is copied encoded, like a skipped 2^t block
+ * in Hwang-Lin; only blocks that actually interleave are decoded and merged element
+ * by element. When the encodings differ the blocks are re-encoded instead.
+ * The merge is stable: on equal keys elements of `a` come first.
+ */
+template <typename T>
+RunFileMergeStats merge_sorted_run_files(SortedRunReader<T>& a, SortedRunReader<T>& b, SortedRunWriter<T>& out) {
+    struct Side {
+        SortedRunReader<T>& reader;
+        std::size_t         block = 0;       // next block of the index
+        std::vector<T>      values;          // decoded current block
+        std::size_t         pos = 0;
+        bool                decoded = false;
+
+        bool       exhausted() const { return !decoded && block >= reader.block_count(); }
+        const T&   head()      const { return decoded ? values[pos] : reader.block(block).min; }
+    };
+
+    RunFileMergeStats stats;
+    Side sa{a, 0, {}, 0, false};
+    Side sb{b, 0, {}, 0, false};
+    std::vector<unsigned char> raw;
+
+    auto decode = [&](Side& s) {
+        s.reader.read_block(s.block++, s.values);
+        s.pos = 0;
+        s.decoded = true;
+        stats.blocks_decoded++;
+    };
+
+    auto copy_block = [&](Side& s) {
+        if (s.reader.encoding() == out.encoding()) {
+            s.reader.read_raw_block(s.block, raw);
+            out.append_encoded_block(s.reader.block(s.block), raw);
+            s.block++;
+            stats.blocks_copied++;
+        } else {
+            decode(s);
+            out.push(s.values.begin(), s.values.end());
+            s.decoded = false;
+        }
+    };
+
+    auto take = [&](Side& s) {
+        out.push(s.values[s.pos++]);
+        if (s.pos == s.values.size()) s.decoded = false;
+    };
+
+    while (!sa.exhausted() || !sb.exhausted()) {
+        if (sa.exhausted() || sb.exhausted()) {
+            Side& rest = sa.exhausted() ? sb : sa;
+            if (rest.decoded) {
+                out.push(rest.values.begin() + rest.pos, rest.values.end());
+                rest.decoded = false;
+            } else {
+                copy_block(rest);
+            }
+            continue;
+        }
+
+        // Whole-block skips through the index.
+        if (!sa.decoded && !(sb.head() < a.block(sa.block).max)) {
+            copy_block(sa);
+            continue;
+        }
+        if (!sb.decoded && b.block(sb.block).max < sa.head()) {
+            copy_block(sb);
+            continue;
+        }
+
+        if (!sa.decoded) decode(sa);
+        if (!sb.decoded) decode(sb);
+
+        // Element-wise merge until one of the current blocks runs out.
+        while (sa.decoded && sb.decoded) {
+            if (!(sb.values[sb.pos] < sa.values[sa.pos])) {
+                take(sa);
+            } else {
+                take(sb);
+            }
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,290 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Sorted flat set / map on a vector with a small sorted staging area that is
+ *              folded into the sorted array by the merge suited to the current size ratio.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "algorithms.hpp"
+#include "tail_merge.hpp"
+
+
+namespace sorted_vector_detail {
+
+struct identity_key {
+    template <typename T>
+    const T& operator()(const T& value) const { return value; }
+};
+
+struct first_key {
+    template <typename Entry>
+    const auto& operator()(const Entry& entry) const { return entry.first; }
+};
+
+/*
+ * Storage shared by sorted_vector_set and sorted_vector_map.
+ *
+ * Elements live in two places: `main_`, sorted and unique, and `stage_`, sorted and
+ * small. insert() inserts into the stage; when the stage is full it is folded into main_
+ * in one merge (flush), so the cost of shifting the sorted array is paid once per stage
+ * instead of once per element. Lookups binary search both parts. Keys are unique across
+ * both parts.
+ *
+ * The fold uses the merge that suits the size ratio of the sorted stage (m) and the
+ * sorted array (n):
+ *   - m == 1     - binary_insertion;
+ *   - m <= n     - hwang_lin_static_tail_merge: in place in the gap at the tail of main_,
+ *                  moving only elements above the stage minimum, with Hwang-Lin block
+ *                  skipping of 2^floor(log2(n/m)) elements;
+ *   - m > n      - two_way_merge into a new array (a bulk insert into a small container).
+ *
+ * Notes:
+ *   - Stage capacity 0 (default) means automatic: sqrt(size()), at least 32, so that a
+ *     fold costs O(size()) moves per sqrt(size()) inserts.
+ *   - The stage is kept sorted rather than appended to: an insert moves up to
+ *     sqrt(size()) staged elements, but a lookup (and so every insert, which checks for
+ *     the key first) costs two binary searches instead of a linear scan of the stage,
+ *     and a flush needs no sort.
+ *   - Iteration flushes the stage first. Pointers returned by find() and iterators are
+ *     invalidated by any modification and by iteration (which may flush).
+ *   - The comparison operators of the elements must order them by key.
+ */
+template <typename Value, typename Key, typename KeyOf>
+class sorted_vector_base {
+public:
+    using value_type     = Value;
+    using key_type       = Key;
+    using size_type      = std::size_t;
+    using const_iterator = typename std::vector<Value>::const_iterator;
+
+    explicit sorted_vector_base(size_type stage_capacity = 0) : stage_capacity_(stage_capacity) {}
+
+    size_type size()  const { return main_.size() + stage_.size(); }
+    bool      empty() const { return size() == 0; }
+
+    void clear() {
+        main_.clear();
+        stage_.clear();
+    }
+
+    void reserve(size_type capacity) { main_.reserve(capacity); }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    const Value* find(const Key& key) const {
+        auto it = lower_bound_key(main_.begin(), main_.end(), key);
+        if (it != main_.end() && !(key < KeyOf{}(*it))) return &*it;
+        it = lower_bound_key(stage_.begin(), stage_.end(), key);
+        if (it != stage_.end() && !(key < KeyOf{}(*it))) return &*it;
+        return nullptr;
+    }
+
+    Value* find(const Key& key) {
+        return const_cast<Value*>(std::as_const(*this).find(key));
+    }
+
+    // Inserts value unless an element with the same key is present.
+    bool insert(const Value& value) {
+        const Key& key = KeyOf{}(value);
+        auto it = lower_bound_key(main_.cbegin(), main_.cend(), key);
+        if (it != main_.cend() && !(key < KeyOf{}(*it))) return false;
+        auto pos = lower_bound_key(stage_.cbegin(), stage_.cend(), key);
+        if (pos != stage_.cend() && !(key < KeyOf{}(*pos))) return false;
+        stage_.insert(pos, value);
+        if (stage_.size() >= stage_capacity()) flush();
+        return true;
+    }
+
+    // Inserts [first, last) with one sort and one merge; keeps the first of equal keys.
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        std::vector<Value> batch(first, last);
+        if (batch.empty()) return;
+        flush();
+
+        std::stable_sort(batch.begin(), batch.end());
+        batch.erase(std::unique(batch.begin(), batch.end(), same_key), batch.end());
+
+        // Drop keys that are already present. The batch is sorted, so each search
+        // gallops from the position of the previous one.
+        auto from = main_.cbegin();
+        auto kept = batch.begin();
+        for (auto it = batch.begin(); it != batch.end(); ++it) {
+            from = gallop_key(from, main_.cend(), KeyOf{}(*it));
+            if (from != main_.cend() && !(KeyOf{}(*it) < KeyOf{}(*from))) continue;
+            if (kept != it) *kept = std::move(*it);
+            ++kept;
+        }
+        batch.erase(kept, batch.end());
+        fold(batch);
+    }
+
+    bool erase(const Key& key) {
+        auto staged = lower_bound_key(stage_.cbegin(), stage_.cend(), key);
+        if (staged != stage_.cend() && !(key < KeyOf{}(*staged))) {
+            stage_.erase(staged);
+            return true;
+        }
+        auto it = lower_bound_key(main_.cbegin(), main_.cend(), key);
+        if (it == main_.cend() || key < KeyOf{}(*it)) return false;
+        main_.erase(it);
+        return true;
+    }
+
+    /*
+     * Removes every element whose key is in [first, last) and returns how many were
+     * removed (merge difference). The positions of the sorted keys in main_ are found
+     * by galloping from the previous position, and the kept runs between
+     * them are shifted left once, so every element after the first removed one moves
+     * exactly once.
+     */
+    template <typename InputIt>
+    size_type erase_batch(InputIt first, InputIt last) {
+        std::vector<Key> keys(first, last);
+        if (keys.empty()) return 0;
+        flush();
+
+        if (!std::is_sorted(keys.begin(), keys.end())) std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        auto write = main_.begin();
+        auto read  = main_.begin();
+        for (const auto& key : keys) {
+            auto pos = gallop_key(read, main_.end(), key);
+            if (pos == main_.end()) break;
+            if (key < KeyOf{}(*pos)) continue;
+            write = (write == read) ? pos : std::move(read, pos, write);
+            read = std::next(pos);
+        }
+        write = (write == read) ? main_.end() : std::move(read, main_.end(), write);
+
+        const size_type removed = static_cast<size_type>(std::distance(write, main_.end()));
+        main_.erase(write, main_.end());
+        return removed;
+    }
+
+    // Folds the (sorted) stage into the sorted array.
+    void flush() const {
+        if (stage_.empty()) return;
+        fold(stage_);
+        stage_.clear();
+    }
+
+    const_iterator begin() const { flush(); return main_.cbegin(); }
+    const_iterator end()   const { flush(); return main_.cend(); }
+
+    size_type stage_capacity() const {
+        if (stage_capacity_ != 0) return stage_capacity_;
+        auto root = static_cast<size_type>(std::sqrt(static_cast<double>(main_.size())));
+        return std::max<size_type>(root, 32);
+    }
+
+protected:
+    static bool same_key(const Value& a, const Value& b) {
+        return !(KeyOf{}(a) < KeyOf{}(b)) && !(KeyOf{}(b) < KeyOf{}(a));
+    }
+
+    template <typename It>
+    static It lower_bound_key(It first, It last, const Key& key) {
+        return std::lower_bound(first, last, key,
+            [](const Value& value, const Key& k) { return KeyOf{}(value) < k; });
+    }
+
+    // lower_bound_key for a key expected close to first: blocks of 1, 2, 4, ... elements
+    // are skipped while their last element is smaller, then the last block is searched.
+    template <typename It>
+    static It gallop_key(It first, It last, const Key& key) {
+        std::size_t step = 1;
+        while (static_cast<std::size_t>(std::distance(first, last)) > step && KeyOf{}(first[step - 1]) < key) {
+            first += step;
+            step *= 2;
+        }
+        return lower_bound_key(first, first + std::min<std::ptrdiff_t>(step, std::distance(first, last)), key);
+    }
+
+    // Merges a sorted batch of new keys into main_.
+    void fold(const std::vector<Value>& batch) const {
+        if (batch.empty()) return;
+        if (batch.size() == 1) {
+            binary_insertion(main_, batch.front());
+        } else if (batch.size() <= main_.size()) {
+            hwang_lin_static_tail_merge(main_, batch);
+        } else {
+            main_ = two_way_merge(main_, batch);
+        }
+    }
+
+    // Flushing reorganizes the storage without changing the contents, so it is also
+    // done by const members (lookups never flush).
+    mutable std::vector<Value> main_;
+    mutable std::vector<Value> stage_;   // Sorted by key.
+    size_type                  stage_capacity_;
+};
+
+// Entry of sorted_vector_map: ordered by key only.
+template <typename K, typename V>
+struct map_entry {
+    K first;
+    V second;
+
+    friend bool operator<(const map_entry& a, const map_entry& b)  { return a.first < b.first; }
+    friend bool operator>(const map_entry& a, const map_entry& b)  { return b.first < a.first; }
+    friend bool operator<=(const map_entry& a, const map_entry& b) { return !(b.first < a.first); }
+    friend bool operator>=(const map_entry& a, const map_entry& b) { return !(a.first < b.first); }
+};
+
+} // namespace sorted_vector_detail
+
+/*
+ * Sorted flat set with batched Hwang-Lin insertion.
+ *
+ * Notes:
+ *   - insert(value), insert(first, last), erase(key), erase_batch(first, last),
+ *     find(key), contains(key), flush(), begin()/end(); see sorted_vector_base.
+ */
+template <typename T>
+class sorted_vector_set : public sorted_vector_detail::sorted_vector_base<T, T, sorted_vector_detail::identity_key> {
+    using base = sorted_vector_detail::sorted_vector_base<T, T, sorted_vector_detail::identity_key>;
+
+public:
+    using base::base;
+};
+
+/*
+ * Sorted flat map with batched Hwang-Lin insertion.
+ *
+ * Elements are map_entry<K, V> with members first and second, like std::pair.
+ *
+ * Notes:
+ *   - Same operations as sorted_vector_set, keyed by K; operator[] inserts V{} if the key
+ *     is absent.
+ */
+template <typename K, typename V>
+class sorted_vector_map : public sorted_vector_detail::sorted_vector_base<
+                              sorted_vector_detail::map_entry<K, V>, K, sorted_vector_detail::first_key> {
+    using base = sorted_vector_detail::sorted_vector_base<
+        sorted_vector_detail::map_entry<K, V>, K, sorted_vector_detail::first_key>;
+
+public:
+    using mapped_type = V;
+    using base::base;
+    using base::insert;
+
+    bool insert(const K& key, const V& value) {
+        return base::insert({key, value});
+    }
+
+    V& operator[](const K& key) {
+        if (auto* entry = base::find(key)) return entry->second;
+        base::insert({key, V{}});
+        return base::find(key)->second;
+    }
+};
@@ -0,0 +1,242 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Pull-based streaming merge of two chunked sorted streams with Hwang-Lin
+ *              block skipping inside the buffered windows.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+
+
+// An immutable chunk of a sorted stream. Chunks are shared so that output can
+// reference input elements without copying them.
+template <typename T>
+using StreamInputChunk = std::shared_ptr<const std::vector<T>>;
+
+// Producer of consecutive chunks of one sorted stream.
+template <typename T>
+class ChunkSource {
+public:
+    // Returns the next non-empty chunk, or nullptr once the stream is exhausted.
+    virtual StreamInputChunk<T> next() = 0;
+    virtual ~ChunkSource() = default;
+};
+
+// Serves an in-memory sorted sequence in chunks of a fixed size.
+template <typename T>
+class VectorChunkSource : public ChunkSource<T> {
+public:
+    VectorChunkSource(std::vector<T> data, std::size_t chunk_size)
+        : data_(std::move(data)), chunk_size_(std::max<std::size_t>(chunk_size, 1)) {}
+
+    StreamInputChunk<T> next() override {
+        if (pos_ >= data_.size()) return nullptr;
+        std::size_t len = std::min(chunk_size_, data_.size() - pos_);
+        auto chunk = std::make_shared<std::vector<T>>(data_.begin() + pos_, data_.begin() + pos_ + len);
+        pos_ += len;
+        return chunk;
+    }
+
+private:
+    std::vector<T> data_;
+    std::size_t    chunk_size_;
+    std::size_t    pos_ = 0;
+};
+
+// Reads a raw binary file of T values (native byte order) in chunks of a fixed size.
+// Stands in for a network layer delivering a sorted stream piece by piece.
+template <typename T>
+class FileChunkSource : public ChunkSource<T> {
+public:
+    FileChunkSource(const std::string& path, std::size_t chunk_size)
+        : in_(path, std::ios::binary), chunk_size_(std::max<std::size_t>(chunk_size, 1)) {
+        if (!in_.is_open()) {
+            throw std::runtime_error("FileChunkSource: unable to open " + path);
+        }
+    }
+
+    StreamInputChunk<T> next() override {
+        auto chunk = std::make_shared<std::vector<T>>(chunk_size_);
+        in_.read(reinterpret_cast<char*>(chunk->data()), static_cast<std::streamsize>(chunk_size_ * sizeof(T)));
+        std::size_t len = static_cast<std::size_t>(in_.gcount()) / sizeof(T);
+        if (len == 0) return nullptr;
+        chunk->resize(len);
+        return chunk;
+    }
+
+private:
+    std::ifstream in_;
+    std::size_t   chunk_size_;
+};
+
+/*
+ * A chunk of merged output: `length` elements starting at `offset` of `owner`.
+ *
+ * When `forwarded` is true the elements were not copied - `owner` is an input chunk
+ * and the range is a block that Hwang-Lin skipping passed through unchanged.
+ * Otherwise `owner` is a buffer of merged elements owned by this chunk alone.
+ */
+template <typename T>
+struct StreamOutputChunk {
+    std::shared_ptr<const std::vector<T>> owner;
+    std::size_t offset = 0;
+    std::size_t length = 0;
+    bool        forwarded = false;
+
+    const T*    begin() const { return owner->data() + offset; }
+    const T*    end()   const { return begin() + length; }
+    std::size_t size()  const { return length; }
+};
+
+/*
+ * Streaming merge cursor.
+ *
+ * Pulls chunks from two ChunkSources on demand and yields merged output chunks of
+ * at most `max_output` elements. Only the current chunk of each side is buffered,
+ * so memory stays O(chunk) per side (plus whatever output chunks the caller keeps).
+ *
+ * Inside the buffered windows each step is a Hwang-Lin static step in the forward
+ * direction: with L the larger window and S the smaller one, t = floor(log2(|L|/|S|))
+ * and the 2^t block at the head of L is tested against the head of S with a single
+ * comparison. Blocks of at least `min_forward` elements that pass the test are
+ * forwarded as zero-copy references into the input chunk; otherwise the head of S
+ * is placed by binary search inside the block and the prefix is copied.
+ *
+ * The merge is stable: on equal keys elements of the first stream come first.
+ */
+template <typename T>
+class StreamingMerge {
+public:
+    StreamingMerge(ChunkSource<T>& a, ChunkSource<T>& b,
+                   std::size_t max_output = 4096, std::size_t min_forward = 64)
+        : a_{&a}, b_{&b},
+          max_output_(std::max<std::size_t>(max_output, 1)),
+          min_forward_(std::max<std::size_t>(min_forward, 1)) {}
+
+    // Returns the next output chunk, or std::nullopt once both streams are exhausted.
+    std::optional<StreamOutputChunk<T>> next() {
+        while (pending_.empty()) {
+            refill(a_);
+            refill(b_);
+
+            if (a_.exhausted() && b_.exhausted()) {
+                flush();
+                break;
+            }
+
+            if (a_.exhausted() || b_.exhausted()) {
+                Side& rest = a_.exhausted() ? b_ : a_;
+                std::size_t len = std::min(rest.window(), max_output_);
+                emit_block(rest, len);
+                continue;
+            }
+
+            step();
+        }
+
+        if (pending_.empty()) return std::nullopt;
+        StreamOutputChunk<T> chunk = std::move(pending_.front());
+        pending_.pop_front();
+        return chunk;
+    }
+
+private:
+    struct Side {
+        ChunkSource<T>*      source;
+        StreamInputChunk<T>  chunk = nullptr;
+        std::size_t          pos = 0;
+        bool                 done = false;
+
+        std::size_t window()    const { return chunk ? chunk->size() - pos : 0; }
+        bool        exhausted() const { return done && window() == 0; }
+        const T&    at(std::size_t i) const { return (*chunk)[pos + i]; }
+    };
+
+    void refill(Side& side) {
+        while (!side.done && side.window() == 0) {
+            side.chunk = side.source->next();
+            side.pos = 0;
+            if (!side.chunk) side.done = true;
+        }
+    }
+
+    // One Hwang-Lin step over the current windows of A and B.
+    void step() {
+        const bool large_is_a = a_.window() > b_.window();
+        Side& large = large_is_a ? a_ : b_;
+        Side& small = large_is_a ? b_ : a_;
+
+        int t = static_cast<int>(std::floor(std::log2(static_cast<double>(large.window()) / small.window())));
+        std::size_t block = std::min<std::size_t>(pow2(t), max_output_);
+        const T& head = small.at(0);
+
+        // A elements precede equal B elements, so the tie rule depends on which side is larger.
+        const T& last = large.at(block - 1);
+        bool block_first = large_is_a ? !(head < last) : last < head;
+
+        if (block_first) {
+            emit_block(large, block);
+            return;
+        }
+
+        // The head of S lands inside the block, before its last element.
+        const T* first = &large.at(0);
+        const T* pos = large_is_a
+            ? std::upper_bound(first, first + block - 1, head)
+            : std::lower_bound(first, first + block - 1, head);
+        copy_out(large, static_cast<std::size_t>(pos - first));
+        copy_out(small, 1);
+    }
+
+    // Forwards `len` elements from the head of `side`: by reference when the block is
+    // large enough, otherwise by copying them into the current output buffer.
+    void emit_block(Side& side, std::size_t len) {
+        if (len < min_forward_) {
+            copy_out(side, len);
+            return;
+        }
+        flush();
+        pending_.push_back({side.chunk, side.pos, len, true});
+        side.pos += len;
+    }
+
+    void copy_out(Side& side, std::size_t len) {
+        while (len > 0) {
+            if (!buffer_) {
+                buffer_ = std::make_shared<std::vector<T>>();
+                buffer_->reserve(max_output_);
+            }
+            std::size_t take = std::min(len, max_output_ - buffer_->size());
+            buffer_->insert(buffer_->end(), side.chunk->begin() + side.pos, side.chunk->begin() + side.pos + take);
+            side.pos += take;
+            len -= take;
+            if (buffer_->size() == max_output_) flush();
+        }
+    }
+
+    void flush() {
+        if (!buffer_ || buffer_->empty()) return;
+        std::size_t len = buffer_->size();
+        pending_.push_back({std::move(buffer_), 0, len, false});
+        buffer_.reset();
+    }
+
+    Side a_;
+    Side b_;
+    std::size_t max_output_;
+    std::size_t min_forward_;
+    std::shared_ptr<std::vector<T>>     buffer_;
+    std::deque<StreamOutputChunk<T>>    pending_;
+};
@@ -0,0 +1,115 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Merging a sorted batch into a sorted vector in place: the vector grows by the
+ *              batch size and the Hwang-Lin merges fill the gap at its tail.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "algorithms.hpp"
+
+
+namespace tail_merge_detail {
+
+// Grows v and merges [suffix, old end) with the batch back to front into [suffix, new end).
+template <typename IterContainer, typename MergeInto>
+void merge_back_to_front(IterContainer& v, const IterContainer& batch, MergeInto merge_into) {
+    if (batch.empty()) return;
+
+    const auto n = v.size();
+    const auto p = static_cast<std::size_t>(
+        std::distance(v.begin(), std::upper_bound(v.begin(), v.end(), batch.front())));
+    v.resize(n + batch.size());
+
+    const auto& cv = std::as_const(v);
+    merge_into(cv.begin() + p, cv.begin() + n, batch.begin(), batch.end(), v.begin() + p);
+}
+
+// Grows v, moves [suffix, old end) to the end and merges its part up to batch.back() with
+// the batch front to back into the gap that opens in front of it.
+//
+// The merge reads the moved suffix while it writes in front of it: after w output
+// elements, r of them from the suffix, the write position is p + w and the read position
+// p + k + r (k = batch size), and w - r never exceeds k. So an element is always read
+// before it is overwritten, and the positions meet only once the batch is used up; from
+// there on the merge copies the rest of its range onto itself. The range therefore ends
+// at the first element greater than batch.back(): that element and the ones after it
+// are already in their final place after the move.
+template <typename IterContainer, typename MergeInto>
+void merge_front_to_back(IterContainer& v, const IterContainer& batch, MergeInto merge_into) {
+    if (batch.empty()) return;
+
+    const auto n = v.size();
+    const auto k = batch.size();
+    const auto p = static_cast<std::size_t>(
+        std::distance(v.begin(), std::upper_bound(v.begin(), v.end(), batch.front())));
+    const auto q = static_cast<std::size_t>(
+        std::distance(v.begin(), std::upper_bound(v.begin() + p, v.end(), batch.back())));
+    v.resize(n + k);
+    std::move_backward(v.begin() + p, v.begin() + n, v.end());
+
+    const auto& cv = std::as_const(v);
+    merge_into(cv.begin() + p + k, cv.begin() + q + k, batch.begin(), batch.end(), v.begin() + p);
+}
+
+} // namespace tail_merge_detail
+
+/*
+ * Algorithm: Tail Gap Merge
+ *
+ * Implementation:
+ *   Developer: Sergei Gorlov
+ *
+ * Parameters:
+ *   IterContainer& v           - sorted container that receives the batch (ideally with
+ *                                spare capacity, so that growing it does not reallocate).
+ *   const IterContainer& batch - sorted batch to insert; usually much smaller than v.
+ *
+ * Notes:
+ *   - The elements of v that are not greater than batch.front() already are in their
+ *     final place and are never touched; only the suffix of v from the insertion point
+ *     of the batch minimum takes part in the merge. Finding that point costs one binary
+ *     search (log |v| comparisons) on top of the merge itself.
+ *   - Static and Knuth variants write from back to front: the write position is never
+ *     before the unread part of v, so the suffix is merged within v without a buffer.
+ *   - Dynamic variants write from front to back: the suffix is first moved to the end
+ *     of the grown vector, which opens the gap in front of it. Elements of v greater than
+ *     batch.back() stay where the move put them (a second binary search).
+ *   - Stable variants keep the elements of v before equal elements of the batch, as if
+ *     the batch were appended and the whole vector stably sorted.
+ *   - Containers must support the methods size(), resize(), begin(), end().
+ */
+template <typename IterContainer>
+void hwang_lin_static_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_back_to_front(v, batch, [](auto... args) { hwang_lin_static_merge_into(args...); });
+}
+
+template <typename IterContainer>
+void hwang_lin_static_stable_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_back_to_front(v, batch, [](auto... args) { hwang_lin_static_stable_merge_into(args...); });
+}
+
+template <typename IterContainer>
+void hwang_lin_knuth_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_back_to_front(v, batch, [](auto... args) { hwang_lin_knuth_merge_into(args...); });
+}
+
+template <typename IterContainer>
+void hwang_lin_knuth_stable_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_back_to_front(v, batch, [](auto... args) { hwang_lin_knuth_stable_merge_into(args...); });
+}
+
+template <typename IterContainer>
+void hwang_lin_dynamic_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_front_to_back(v, batch, [](auto... args) { hwang_lin_dynamic_merge_into(args...); });
+}
+
+template <typename IterContainer>
+void hwang_lin_dynamic_stable_tail_merge(IterContainer& v, const IterContainer& batch) {
+    tail_merge_detail::merge_front_to_back(v, batch, [](auto... args) { hwang_lin_dynamic_stable_merge_into(args...); });
+}
@@ -0,0 +1,119 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Fixed pool of worker threads running indexed tasks (parallel for).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+
+/*
+ * Fixed-size thread pool.
+ *
+ * The workers are started once and sleep between calls. parallel_for(tasks, fn)
+ * calls fn(worker, task) for every task in [0, tasks) and returns when all of them
+ * are done. Tasks are handed out one at a time from a shared counter, so uneven
+ * tasks balance themselves. The calling thread takes part as worker 0; `worker`
+ * is always below size(), which makes it usable as an index into per-thread state.
+ *
+ * Notes:
+ *   - One parallel_for at a time: the pool is not reentrant.
+ *   - fn must not throw.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(threads, 1);
+        for (std::size_t id = 1; id < threads; ++id) {
+            workers_.emplace_back([this, id] { workerLoop(id); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    // Number of threads running tasks, including the caller.
+    std::size_t size() const { return workers_.size() + 1; }
+
+    template <typename F>
+    void parallel_for(std::size_t tasks, F&& fn) {
+        if (tasks == 0) return;
+        if (workers_.empty() || tasks == 1) {
+            for (std::size_t task = 0; task < tasks; ++task) fn(std::size_t{0}, task);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &fn;
+            invoke_ = [](void* job, std::size_t worker, std::size_t task) {
+                (*static_cast<std::remove_reference_t<F>*>(job))(worker, task);
+            };
+            tasks_ = tasks;
+            next_.store(0, std::memory_order_relaxed);
+            pending_ = workers_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+private:
+    void workerLoop(std::size_t id) {
+        std::size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+
+            work(id);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+
+    void work(std::size_t worker) {
+        for (std::size_t task; (task = next_.fetch_add(1, std::memory_order_relaxed)) < tasks_;) {
+            invoke_(job_, worker, task);
+        }
+    }
+
+    std::vector<std::thread>  workers_;
+    std::mutex                mutex_;
+    std::condition_variable   start_;
+    std::condition_variable   done_;
+    bool                      stop_ = false;
+    std::size_t               generation_ = 0;
+    std::size_t               pending_ = 0;
+
+    // Current parallel_for: a type-erased reference to the caller's functor.
+    void*                     job_ = nullptr;
+    void                    (*invoke_)(void*, std::size_t, std::size_t) = nullptr;
+    std::size_t               tasks_ = 0;
+    std::atomic<std::size_t>  next_{0};
+};
@@ -0,0 +1,171 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Top-k and rank-range merges: only the requested window of the merged
+ *              sequence is produced, after locating its ends by co-rank binary searches.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "algorithms.hpp"
+#include "merge_select.hpp"
+
+
+namespace top_k_merge_detail {
+
+// Splits of the stable merge at ranks lo and hi (lo < hi <= m + n). The second search is
+// confined to [i_lo, i_lo + (hi - lo)], so it costs O(log(hi - lo)) comparisons.
+template <typename RandomIt1, typename RandomIt2>
+std::pair<MergeSplit, MergeSplit> window_splits(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last,
+                                                std::size_t lo, std::size_t hi) {
+    const auto m = static_cast<std::size_t>(std::distance(a_first, a_last));
+    const auto n = static_cast<std::size_t>(std::distance(b_first, b_last));
+    const MergeSplit first = co_rank(a_first, a_last, b_first, b_last, lo);
+    const std::size_t i = merge_select_detail::co_rank_in(a_first, b_first, hi,
+        std::max(first.i, merge_select_detail::co_rank_low(n, hi)),
+        std::min(first.i + (hi - lo), merge_select_detail::co_rank_high(m, hi)));
+    return {first, {i, hi - i}};
+}
+
+/*
+ * Stable Hwang-Lin merge that works front to back: the longer input is consumed in blocks
+ * of 2^floor(log2(long / short)) elements; a block is copied whole if its last element
+ * precedes the head of the shorter input, otherwise the head is inserted into the block
+ * by binary search. The remainder (less than one block of the longer input) is merged
+ * with two_way_merge_into. Needs only an output iterator.
+ */
+template <typename RandomIt1, typename RandomIt2, typename OutputIt>
+OutputIt forward_hwang_lin_merge_into(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last, OutputIt out) {
+    const auto m = static_cast<std::size_t>(std::distance(a_first, a_last));
+    const auto n = static_cast<std::size_t>(std::distance(b_first, b_last));
+    if (m == 0) return std::copy(b_first, b_last, out);
+    if (n == 0) return std::copy(a_first, a_last, out);
+
+    if (n >= m) {
+        const auto block = static_cast<std::ptrdiff_t>(bit_floor(n / m));
+        while (a_first != a_last && b_last - b_first >= block) {
+            if (b_first[block - 1] < *a_first) {
+                out = std::copy(b_first, b_first + block, out);
+                b_first += block;
+            } else {
+                // Elements of b equal to a's head go after it.
+                auto pos = std::lower_bound(b_first, b_first + (block - 1), *a_first);
+                out = std::copy(b_first, pos, out);
+                *out++ = *a_first++;
+                b_first = pos;
+            }
+        }
+    } else {
+        const auto block = static_cast<std::ptrdiff_t>(bit_floor(m / n));
+        while (b_first != b_last && a_last - a_first >= block) {
+            if (!(*b_first < a_first[block - 1])) {
+                out = std::copy(a_first, a_first + block, out);
+                a_first += block;
+            } else {
+                // Elements of a equal to b's head go before it.
+                auto pos = std::upper_bound(a_first, a_first + (block - 1), *b_first);
+                out = std::copy(a_first, pos, out);
+                *out++ = *b_first++;
+                a_first = pos;
+            }
+        }
+    }
+    return two_way_merge_into(a_first, a_last, b_first, b_last, out);
+}
+
+} // namespace top_k_merge_detail
+
+// Iterator core of rank_range_merge: writes elements [lo, hi) of the stable merge of
+// [a_first, a_last) and [b_first, b_last) to out and returns the end of the written range.
+template <typename RandomIt1, typename RandomIt2, typename OutputIt>
+OutputIt rank_range_merge_into(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last,
+                               std::size_t lo, std::size_t hi, OutputIt out) {
+    hi = std::min<std::size_t>(hi, std::distance(a_first, a_last) + std::distance(b_first, b_last));
+    if (lo >= hi) return out;
+
+    const auto [first, last] = top_k_merge_detail::window_splits(a_first, a_last, b_first, b_last, lo, hi);
+    return two_way_merge_into(a_first + first.i, a_first + last.i, b_first + first.j, b_first + last.j, out);
+}
+
+// Iterator core of hwang_lin_rank_range_merge: as rank_range_merge_into, but the window is
+// merged with forward Hwang-Lin block skipping.
+template <typename RandomIt1, typename RandomIt2, typename OutputIt>
+OutputIt hwang_lin_rank_range_merge_into(RandomIt1 a_first, RandomIt1 a_last, RandomIt2 b_first, RandomIt2 b_last,
+                                         std::size_t lo, std::size_t hi, OutputIt out) {
+    hi = std::min<std::size_t>(hi, std::distance(a_first, a_last) + std::distance(b_first, b_last));
+    if (lo >= hi) return out;
+
+    const auto [first, last] = top_k_merge_detail::window_splits(a_first, a_last, b_first, b_last, lo, hi);
+    return top_k_merge_detail::forward_hwang_lin_merge_into(a_first + first.i, a_first + last.i,
+                                                            b_first + first.j, b_first + last.j, out);
+}
+
+/*
+ * Algorithm: Rank-Range Merge
+ *
+ * Implementation:
+ *   Developer: Igor Stikentzin
+ *
+ * Parameters:
+ *   const IterContainer& a - container with a sorted sequence. Elements must be in ascending order.
+ *   const IterContainer& b - container with a sorted sequence. Elements must be in ascending order.
+ *   std::size_t lo, hi     - ranks of the window [lo, hi) of the merged sequence; hi is
+ *                            clamped to a.size() + b.size().
+ *
+ * Return Value:
+ *   IterContainer - elements lo..hi-1 of the stable merge of a and b (a before b on equal
+ *                   elements); empty if lo >= hi.
+ *
+ * Notes:
+ *   - The window's ends in a and b are found by co_rank (the second search confined to the
+ *     window), so the cost is O(hi - lo) plus O(log min(m, n)) comparisons, independent of
+ *     a.size() + b.size().
+ *   - hwang_lin_rank_range_merge merges the window with Hwang-Lin block skipping from the
+ *     front, which needs fewer comparisons when the window is skewed towards one input.
+ */
+template <typename IterContainer>
+IterContainer rank_range_merge(const IterContainer& a, const IterContainer& b, std::size_t lo, std::size_t hi) {
+    hi = std::min(hi, a.size() + b.size());
+    IterContainer result(lo < hi ? hi - lo : 0);
+    rank_range_merge_into(a.begin(), a.end(), b.begin(), b.end(), lo, hi, result.begin());
+    return result;
+}
+
+template <typename IterContainer>
+IterContainer hwang_lin_rank_range_merge(const IterContainer& a, const IterContainer& b, std::size_t lo, std::size_t hi) {
+    hi = std::min(hi, a.size() + b.size());
+    IterContainer result(lo < hi ? hi - lo : 0);
+    hwang_lin_rank_range_merge_into(a.begin(), a.end(), b.begin(), b.end(), lo, hi, result.begin());
+    return result;
+}
+
+/*
+ * Algorithm: Top-k Merge
+ *
+ * Implementation:
+ *   Developer: Igor Stikentzin
+ *
+ * Parameters:
+ *   const IterContainer& a - container with a sorted sequence. Elements must be in ascending order.
+ *   const IterContainer& b - container with a sorted sequence. Elements must be in ascending order.
+ *   std::size_t k          - number of leading merged elements to produce.
+ *
+ * Return Value:
+ *   IterContainer - the first min(k, a.size() + b.size()) elements of the stable merge.
+ *
+ * Notes:
+ *   - rank_range_merge with the window [0, k): O(k + log min(m, n)) comparisons.
+ */
+template <typename IterContainer>
+IterContainer top_k_merge(const IterContainer& a, const IterContainer& b, std::size_t k) {
+    return rank_range_merge(a, b, 0, k);
+}
+
+template <typename IterContainer>
+IterContainer hwang_lin_top_k_merge(const IterContainer& a, const IterContainer& b, std::size_t k) {
+    return hwang_lin_rank_range_merge(a, b, 0, k);
+}
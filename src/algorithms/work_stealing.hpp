@@ -0,0 +1,196 @@
+/*
+ * Authors: Sergei Gorlov and Igor Stikentzin.
+ * Description: Work-stealing scheduler for fork-join recursion (per-thread deques).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Work-stealing fork-join scheduler.
+ *
+ * Every thread owns a deque of tasks. fork_join(left, right) pushes `right` to the
+ * bottom of the current thread's deque, runs `left` and then pops `right` back and
+ * runs it itself - unless an idle thread has stolen it from the top of the deque in
+ * the meantime. While waiting for a stolen task the thread keeps executing other
+ * tasks, so no thread blocks as long as there is work. Owners work LIFO at the
+ * bottom (depth first, cache friendly), thieves take the oldest and largest tasks
+ * from the top.
+ *
+ * run(root) executes root on the calling thread, which joins as worker 0, and
+ * returns when root and everything it forked has finished. Between runs the other
+ * workers sleep.
+ *
+ * Notes:
+ *   - fork_join outside of run() (or from a foreign thread) runs both parts sequentially.
+ *   - Tasks must not throw.
+ *   - One run() at a time.
+ */
+class WorkStealingScheduler {
+public:
+    explicit WorkStealingScheduler(std::size_t threads = std::thread::hardware_concurrency()) {
+        threads = std::max<std::size_t>(threads, 1);
+        queues_.reserve(threads);
+        for (std::size_t id = 0; id < threads; ++id) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (std::size_t id = 1; id < threads; ++id) {
+            workers_.emplace_back([this, id] { workerLoop(id); });
+        }
+    }
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    ~WorkStealingScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    std::size_t size() const { return queues_.size(); }
+
+    template <typename F>
+    void run(F&& root) {
+        if (current_.scheduler == this) {
+            root(); // nested call from inside a task
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = true;
+        }
+        wake_.notify_all();
+
+        current_ = {this, 0};
+        root();
+        current_ = {nullptr, 0};
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+
+    template <typename Left, typename Right>
+    void fork_join(Left&& left, Right&& right) {
+        if (current_.scheduler != this || queues_.size() == 1) {
+            left();
+            right();
+            return;
+        }
+
+        const std::size_t id = current_.id;
+        TaskFor<Right> task(right);
+        push(id, &task);
+
+        left();
+
+        // Every task forked by `left` has been joined, so the bottom of the deque is
+        // either `task` or - if it was stolen - the deque holds nothing of ours.
+        if (popBottom(id) == &task) {
+            right();
+            return;
+        }
+        while (!task.done.load(std::memory_order_acquire)) {
+            if (!runOne(id)) std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Task {
+        void (*execute)(Task*) = nullptr;
+        std::atomic<bool> done{false};
+    };
+
+    template <typename F>
+    struct TaskFor : Task {
+        explicit TaskFor(F& fn) : fn(fn) {
+            this->execute = [](Task* task) {
+                auto* self = static_cast<TaskFor*>(task);
+                self->fn();
+                self->done.store(true, std::memory_order_release);
+            };
+        }
+        F& fn;
+    };
+
+    struct alignas(64) Queue {
+        std::mutex        mutex;
+        std::deque<Task*> tasks;
+    };
+
+    // Scheduler and worker index of the calling thread.
+    struct Current {
+        WorkStealingScheduler* scheduler;
+        std::size_t            id;
+    };
+
+    void push(std::size_t id, Task* task) {
+        std::lock_guard<std::mutex> lock(queues_[id]->mutex);
+        queues_[id]->tasks.push_back(task);
+    }
+
+    Task* popBottom(std::size_t id) {
+        std::lock_guard<std::mutex> lock(queues_[id]->mutex);
+        auto& tasks = queues_[id]->tasks;
+        if (tasks.empty()) return nullptr;
+        Task* task = tasks.back();
+        tasks.pop_back();
+        return task;
+    }
+
+    Task* steal(std::size_t victim) {
+        std::unique_lock<std::mutex> lock(queues_[victim]->mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queues_[victim]->tasks.empty()) return nullptr;
+        Task* task = queues_[victim]->tasks.front();
+        queues_[victim]->tasks.pop_front();
+        return task;
+    }
+
+    // Runs one task: the newest of our own, else the oldest of another thread.
+    bool runOne(std::size_t id) {
+        Task* task = popBottom(id);
+        for (std::size_t i = 1; !task && i < queues_.size(); ++i) {
+            task = steal((id + i) % queues_.size());
+        }
+        if (!task) return false;
+        task->execute(task);
+        return true;
+    }
+
+    void workerLoop(std::size_t id) {
+        current_ = {this, id};
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stop_ || running_; });
+                if (stop_) return;
+            }
+            while (running_.load(std::memory_order_relaxed)) {
+                if (!runOne(id)) std::this_thread::yield();
+            }
+        }
+    }
+
+    inline static thread_local Current current_{nullptr, 0};
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread>            workers_;
+    std::mutex                          mutex_;
+    std::condition_variable             wake_;
+    bool                                stop_ = false;
+    std::atomic<bool>                   running_{false};
+};
@@ -10,16 +10,46 @@
 #include "generate_sorted_vectors.hpp"
 #include "test_scenarious.hpp"
 #include "counting_int.hpp"
+#include "perf_counters.hpp"
+#include "allocation_tracker.hpp"
+#include "dataset_cache.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <iomanip>
+#include <memory>
 #include <fstream>
 #include <vector>
 
 constexpr int REPORT_WIDTH = 110;
 
+// Name of the key type the timings were measured on, for reports.
+template <typename T>
+std::string keyTypeName() {
+    if constexpr (std::is_same_v<T, CountingInt>)  return "CountingInt";
+    else if constexpr (std::is_same_v<T, std::int32_t>) return "int32";
+    else if constexpr (std::is_same_v<T, std::int64_t>) return "int64";
+    else if constexpr (std::is_same_v<T, double>) return "double";
+    else return "custom";
+}
+
+// Plain keys of the generated elements: the values without source tag and index.
+template <typename T>
+std::vector<T> toKeys(const std::vector<CountingInt>& values) {
+    std::vector<T> keys;
+    keys.reserve(values.size());
+    for (const auto& x : values) {
+        keys.push_back(static_cast<T>(x.value));
+    }
+    return keys;
+}
+
 class AlgorithmTester {
 public:
 explicit AlgorithmTester(
@@ -27,7 +57,7 @@ explicit AlgorithmTester(
     int colWidthScenario = 10,
     int colWidthSizeA    = 8,
     int colWidthSizeB    = 8,
-    int colWidthCase     = 22,
+    int colWidthCase     = 36,
     int colWidthTime     = 12,
     int colWidthComp     = 14,
     int colWidthStable   = 10,
@@ -47,65 +77,148 @@ explicit AlgorithmTester(
         scenarios_.push_back(scenario);
     }
 
-    std::vector<TestScenarioResult> runTests(MergeAlgorithm& algorithm) {
+    const std::vector<TestScenario>& getScenarios() const {
+        return scenarios_;
+    }
+
+    void setTiming(const TimingConfig& timing) {
+        timing_ = timing;
+    }
+
+    const TimingConfig& getTiming() const {
+        return timing_;
+    }
+
+    // Test data from `cache` (not owned) instead of generating it for every run, so all
+    // algorithms run on the same datasets; nullptr, the default, generates every run.
+    void setDatasetCache(DatasetCache* cache) {
+        datasetCache_ = cache;
+    }
+
+    // Progress lines ("Running scenario: ...") on stdout; on by default.
+    void setVerbose(bool verbose) {
+        verbose_ = verbose;
+    }
+
+    // Times, counts and checks one algorithm on CountingInt elements.
+    std::vector<TestScenarioResult> runTests(MergeAlgorithm<CountingInt>& algorithm) {
+        return runTests(algorithm, algorithm);
+    }
+
+    // Times `timed` on plain keys of type T (converted from the generated values) and runs
+    // `counted`, the same algorithm on CountingInt, untimed on the same data for the
+    // comparison count and the stability check. For T = CountingInt one run does both.
+    template <typename T>
+    std::vector<TestScenarioResult> runTests(MergeAlgorithm<T>& timed, MergeAlgorithm<CountingInt>& counted) {
         std::vector<TestScenarioResult> results;
 
         for (const auto& scenario : scenarios_) {
-            std::cout << "Running scenario: A = " << scenario.sizeA
-                      << ", B = " << scenario.sizeB
-                      << ", Case = " << toString(scenario.caseType) << std::endl;
+            if (verbose_) {
+                std::cout << "Running scenario: A = " << scenario.sizeA
+                          << ", B = " << scenario.sizeB
+                          << ", Case = " << caseName(scenario) << std::endl;
+            }
 
-            double total_time = 0.0;
+            std::vector<double> times;
             long long total_comparisons = 0;
+            CounterTotals counter_totals;
+            ElementOperations total_operations;
+            AllocationStats total_allocations;
             bool is_correct = true;
             bool is_stable = true;
 
-            MergeTestCase test_case = generate_sorted_vectors(
-                scenario.sizeA, scenario.sizeB, scenario.caseType,
-                scenario.randomMin, scenario.randomMax,
-                scenario.blockSizeA, scenario.blockSizeB
-            );
+            // Warm-up runs are checked but not timed; every run gets fresh input data (with
+            // a dataset cache, the next of its datasets for the scenario).
+            const int max_runs = timing_.warmup + std::max(timing_.maxRepetitions, 1);
+            const int counted_runs = std::max(1, std::min(timing_.minRepetitions, timing_.maxRepetitions));
+            for (int run = 0; run < max_runs; run++) {
+                std::shared_ptr<const MergeTestCase> data = datasetCache_
+                    ? datasetCache_->load(scenario, run)
+                    : std::make_shared<const MergeTestCase>(generateTestCase(scenario, run));
+                const MergeTestCase& test_case = *data;
 
-            CountingInt::resetCounter();
+                double elapsed = 0.0;
+                long long comparisons = 0;
+                PerfCounterValues counters;
+                ElementOperations operations;
+                AllocationStats allocations;
+                std::vector<CountingInt> result;
+                // Runs whose counts go into the result (see counted_runs below).
+                const bool counted_run = run >= timing_.warmup && static_cast<int>(times.size()) < counted_runs;
 
-            auto start = std::chrono::high_resolution_clock::now();
-            auto result = algorithm.merge(test_case.a, test_case.b);
-            auto end = std::chrono::high_resolution_clock::now();
-            double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+                if constexpr (std::is_same_v<T, CountingInt>) {
+                    CountingInt::resetCounter();
 
-            total_time += elapsed;
-            total_comparisons += CountingInt::comparisons;
+                    counters_.start();
+                    auto start = std::chrono::high_resolution_clock::now();
+                    result = timed.merge(test_case.a, test_case.b);
+                    auto end = std::chrono::high_resolution_clock::now();
+                    counters = counters_.stop();
+                    elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+                    comparisons = CountingInt::comparisons;  // Before the checks below compare too.
+                    operations = CountingInt::operations;
 
-            if (result != test_case.result) {
-                is_correct = false;
-            }
+                    if (counted_run) {
+                        allocations = measureAllocations([&]() { return timed.merge(test_case.a, test_case.b); });
+                    }
+                } else {
+                    std::vector<T> keys_a = toKeys<T>(test_case.a);
+                    std::vector<T> keys_b = toKeys<T>(test_case.b);
+
+                    counters_.start();
+                    auto start = std::chrono::high_resolution_clock::now();
+                    std::vector<T> keys = timed.merge(keys_a, keys_b);
+                    auto end = std::chrono::high_resolution_clock::now();
+                    counters = counters_.stop();
+                    elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+
+                    if (counted_run) {
+                        allocations = measureAllocations([&]() { return timed.merge(keys_a, keys_b); });
+                    }
 
-            bool iteration_stable = true;
-            for (size_t j = 1; j < result.size(); j++) {
-                if (result[j - 1].value == result[j].value) {
-                    if (result[j - 1].source == result[j].source) {
-                        // For elements from the same slice, ensure original order is preserved.
-                        if (result[j - 1].index > result[j].index) {
-                            iteration_stable = false;
-                            break;
-                        }
-                    } else {
-                        // For elements from different slices, element from A must come first.
-                        if (result[j - 1].source == Slice::B && result[j].source == Slice::A) {
-                            iteration_stable = false;
-                            break;
-                        }
+                    if (keys != toKeys<T>(test_case.result)) {
+                        is_correct = false;
                     }
+
+                    CountingInt::resetCounter();
+                    result = counted.merge(test_case.a, test_case.b);
+                    comparisons = CountingInt::comparisons;
+                    operations = CountingInt::operations;
+                }
+
+                if (result != test_case.result) {
+                    is_correct = false;
+                }
+                if (!isStableResult(result)) {
+                    is_stable = false;
+                }
+
+                if (run < timing_.warmup) {
+                    continue;
+                }
+                times.push_back(elapsed);
+                counter_totals.add(counters);
+                // Counts only over the runs every scenario gets, so that they do not depend on
+                // how many repetitions the timing needed and a seed reproduces them.
+                if (counted_run) {
+                    total_comparisons += comparisons;
+                    total_operations += operations;
+                    total_allocations.allocations += allocations.allocations;
+                    total_allocations.bytes += allocations.bytes;
+                    total_allocations.peakBytes = std::max(total_allocations.peakBytes, allocations.peakBytes);
                 }
-            }
-            if (!iteration_stable) {
-                is_stable = false;
-            }
 
+                if (static_cast<int>(times.size()) >= timing_.minRepetitions && isPreciseEnough(times)) {
+                    break;
+                }
+            }
 
-            double avg_time = total_time;
-            long long avg_comparisons = total_comparisons;
-            results.push_back({scenario, avg_time, avg_comparisons, is_correct, is_stable});
+            TimingStats timing = computeTimingStats(times);
+            const std::size_t counted = std::min(times.size(), static_cast<std::size_t>(counted_runs));
+            long long avg_comparisons = total_comparisons / static_cast<long long>(counted);
+            results.push_back({scenario, timing.median, avg_comparisons, is_correct, is_stable, timing, keyTypeName<T>(),
+                               counter_totals.mean(), meanOperations(total_operations, counted),
+                               meanAllocations(total_allocations, counted), sorted_vectors_seed()});
         }
 
         return results;
@@ -117,7 +230,10 @@ explicit AlgorithmTester(
         // Set floating-point precision for average time
         oss << std::fixed << std::setprecision(6);
 
-        const std::string separator(REPORT_WIDTH, '-');
+        // Counter columns only when some scenario has them; the CSV always has them.
+        const bool with_counters = std::any_of(results.begin(), results.end(),
+            [](const TestScenarioResult& res) { return res.counters.isAvailable(); });
+        const std::string separator(std::max(REPORT_WIDTH, tableWidth(with_counters)), '-');
 
         oss << "Test Report:\n" << separator << "\n";
 
@@ -127,11 +243,35 @@ explicit AlgorithmTester(
             << std::setw(colWidthSizeA_)    << "SizeA"
             << std::setw(colWidthSizeB_)    << "SizeB"
             << std::setw(colWidthCase_)     << "Case"
-            << std::setw(colWidthTime_)     << "Time(ms)"
+            << std::setw(colWidthKey_)      << "Key"
+            << std::setw(colWidthTime_)     << "Min(ms)"
+            << std::setw(colWidthTime_)     << "Median(ms)"
+            << std::setw(colWidthTime_)     << "Mean(ms)"
+            << std::setw(colWidthTime_)     << "P90(ms)"
+            << std::setw(colWidthTime_)     << "P99(ms)"
+            << std::setw(colWidthTime_)     << "StdDev(ms)"
+            << std::setw(colWidthReps_)     << "Reps"
             << std::setw(colWidthComp_)     << "Comparisons"
+            << std::setw(colWidthOps_)      << "CopyCtor"
+            << std::setw(colWidthOps_)      << "CopyAssign"
+            << std::setw(colWidthOps_)      << "MoveCtor"
+            << std::setw(colWidthOps_)      << "MoveAssign"
+            << std::setw(colWidthOps_)      << "Swaps"
+            << std::setw(colWidthOps_)      << "Allocs"
+            << std::setw(colWidthBytes_)    << "AllocBytes"
+            << std::setw(colWidthBytes_)    << "PeakBytes"
             << std::setw(colWidthStable_)   << "Stable"
-            << std::setw(colWidthResult_)   << "Result"
-            << "\n";
+            << std::setw(colWidthResult_)   << "Result";
+        if (with_counters) {
+            oss << std::setw(colWidthCount_) << "Cycles"
+                << std::setw(colWidthCount_) << "Instructions"
+                << std::setw(colWidthIpc_)   << "IPC"
+                << std::setw(colWidthCount_) << "BranchMiss"
+                << std::setw(colWidthCount_) << "L1DMiss"
+                << std::setw(colWidthCount_) << "LLCMiss"
+                << std::setw(colWidthCount_) << "dTLBMiss";
+        }
+        oss << "\n";
 
         oss << separator << "\n";
 
@@ -141,15 +281,44 @@ explicit AlgorithmTester(
                 << std::setw(colWidthScenario_) << "Scenario"
                 << std::setw(colWidthSizeA_)    << res.scenario.sizeA
                 << std::setw(colWidthSizeB_)    << res.scenario.sizeB
-                << std::setw(colWidthCase_)     << toString(res.scenario.caseType)
-                << std::setw(colWidthTime_)     << res.time
+                << std::setw(colWidthCase_)     << caseName(res.scenario)
+                << std::setw(colWidthKey_)      << res.keyType
+                << std::setw(colWidthTime_)     << res.timing.min
+                << std::setw(colWidthTime_)     << res.timing.median
+                << std::setw(colWidthTime_)     << res.timing.mean
+                << std::setw(colWidthTime_)     << res.timing.p90
+                << std::setw(colWidthTime_)     << res.timing.p99
+                << std::setw(colWidthTime_)     << res.timing.stddev
+                << std::setw(colWidthReps_)     << res.timing.repetitions
                 << std::setw(colWidthComp_)     << res.compressions
+                << std::setw(colWidthOps_)      << res.operations.copyConstructions
+                << std::setw(colWidthOps_)      << res.operations.copyAssignments
+                << std::setw(colWidthOps_)      << res.operations.moveConstructions
+                << std::setw(colWidthOps_)      << res.operations.moveAssignments
+                << std::setw(colWidthOps_)      << res.operations.swaps
+                << std::setw(colWidthOps_)      << res.allocations.allocations
+                << std::setw(colWidthBytes_)    << res.allocations.bytes
+                << std::setw(colWidthBytes_)    << res.allocations.peakBytes
                 << std::setw(colWidthStable_)   << (res.isStable ? "Stable" : "Unstable")
-                << std::setw(colWidthResult_)   << (res.isCorrect ? "Correct" : "Incorrect")
-                << "\n";
+                << std::setw(colWidthResult_)   << (res.isCorrect ? "Correct" : "Incorrect");
+            if (with_counters) {
+                const PerfCounterValues& c = res.counters;
+                oss << std::setw(colWidthCount_) << counterText(c.cycles)
+                    << std::setw(colWidthCount_) << counterText(c.instructions)
+                    << std::setw(colWidthIpc_)   << ipcText(c.ipc())
+                    << std::setw(colWidthCount_) << counterText(c.branchMisses)
+                    << std::setw(colWidthCount_) << counterText(c.l1dMisses)
+                    << std::setw(colWidthCount_) << counterText(c.llcMisses)
+                    << std::setw(colWidthCount_) << counterText(c.dtlbMisses);
+            }
+            oss << "\n";
         }
 
         oss << separator << "\n";
+        if (!with_counters) {
+            oss << "Hardware counters: unavailable"
+                << (counters_.isAvailable() ? "" : " (" + counters_.getUnavailableReason() + ")") << "\n";
+        }
 
         return oss.str();
     }
@@ -160,25 +329,202 @@ explicit AlgorithmTester(
             std::cerr << "Error: unable to open file " << filename << " for writing." << std::endl;
             return;
         }
+        writeCSV(file, results);
+        file.close();
+    }
+
+    // CSV rows of the results; with a non-empty `algorithm` every row starts with an
+    // Algorithm column, so that several algorithms can share one stream.
+    void writeCSV(std::ostream& file, const std::vector<TestScenarioResult>& results,
+                  bool header = true, const std::string& algorithm = "") {
+        const std::string prefix = algorithm.empty() ? "" : algorithm + ",";
 
         // Write CSV header.
-        file << "TestCase,M,N,Case,Time(ms),Comparisons,Stable,Correct\n";
+        // Time(ms) is the median on KeyType keys; the other timing columns follow the original ones.
+        if (header) {
+            file << (algorithm.empty() ? "" : "Algorithm,")
+                 << "TestCase,M,N,Case,Time(ms),Comparisons,Stable,Correct,"
+                 << "Min(ms),Median(ms),Mean(ms),P90(ms),P99(ms),StdDev(ms),Repetitions,KeyType,"
+                 << "Cycles,Instructions,IPC,BranchMisses,L1DMisses,LLCMisses,DTLBMisses,"
+                 << "CopyConstructions,CopyAssignments,MoveConstructions,MoveAssignments,Swaps,"
+                 << "Allocations,AllocatedBytes,PeakBytes,Seed\n";
+        }
 
         // Write each iteration result as a row.
         for (const auto& res : results) {
             // Use a helper function to convert case type to string (e.g., toString(res.scenario.caseType)).
-            file << "Scenario" << ","  // You might want to number or name your scenarios.
+            file << prefix << "Scenario" << ","  // You might want to number or name your scenarios.
                  << res.scenario.sizeA << ","
                  << res.scenario.sizeB << ","
-                 << toString(res.scenario.caseType) << ","
+                 << caseName(res.scenario) << ","
                  << res.time << ","
                  << res.compressions << ","
                  << (res.isStable ? "Stable" : "Unstable") << ","
-                 << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+                 << (res.isCorrect ? "Correct" : "Incorrect") << ","
+                 << res.timing.min << ","
+                 << res.timing.median << ","
+                 << res.timing.mean << ","
+                 << res.timing.p90 << ","
+                 << res.timing.p99 << ","
+                 << res.timing.stddev << ","
+                 << res.timing.repetitions << ","
+                 << res.keyType << ","
+                 << csvCounter(res.counters.cycles) << ","
+                 << csvCounter(res.counters.instructions) << ","
+                 << (res.counters.ipc() < 0 ? "" : std::to_string(res.counters.ipc())) << ","
+                 << csvCounter(res.counters.branchMisses) << ","
+                 << csvCounter(res.counters.l1dMisses) << ","
+                 << csvCounter(res.counters.llcMisses) << ","
+                 << csvCounter(res.counters.dtlbMisses) << ","
+                 << res.operations.copyConstructions << ","
+                 << res.operations.copyAssignments << ","
+                 << res.operations.moveConstructions << ","
+                 << res.operations.moveAssignments << ","
+                 << res.operations.swaps << ","
+                 << res.allocations.allocations << ","
+                 << res.allocations.bytes << ","
+                 << res.allocations.peakBytes << ","
+                 << res.seed << "\n";
         }
-        file.close();
     }
 private:
+    // Stability of a merge result: equal values keep their input order, A before B.
+    static bool isStableResult(const std::vector<CountingInt>& result) {
+        for (size_t j = 1; j < result.size(); j++) {
+            if (result[j - 1].value == result[j].value) {
+                if (result[j - 1].source == result[j].source) {
+                    // For elements from the same slice, ensure original order is preserved.
+                    if (result[j - 1].index > result[j].index) {
+                        return false;
+                    }
+                } else {
+                    // For elements from different slices, element from A must come first.
+                    if (result[j - 1].source == Slice::B && result[j].source == Slice::A) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    // Two-sided 97.5% quantile of Student's t distribution with `df` degrees of freedom.
+    static double studentT975(int df) {
+        static const double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+        };
+        if (df < 1) return table[0];
+        if (df <= 30) return table[df - 1];
+        return 1.960;
+    }
+
+    // Stop rule: the 95% confidence interval of the mean is at most relativeCI * mean wide.
+    bool isPreciseEnough(const std::vector<double>& times) const {
+        if (times.size() < 2) return false;
+        TimingStats stats = computeTimingStats(times);
+        if (stats.mean <= 0.0) return true;
+        double halfWidth = studentT975(static_cast<int>(times.size()) - 1) * stats.stddev / std::sqrt(static_cast<double>(times.size()));
+        return 2.0 * halfWidth <= timing_.relativeCI * stats.mean;
+    }
+
+    // Percentiles interpolate linearly between the closest ranks; stddev is the sample one.
+    static TimingStats computeTimingStats(std::vector<double> times) {
+        TimingStats stats;
+        stats.repetitions = static_cast<int>(times.size());
+        if (times.empty()) return stats;
+
+        std::sort(times.begin(), times.end());
+        auto percentile = [&](double p) {
+            double rank = p * static_cast<double>(times.size() - 1);
+            size_t lower = static_cast<size_t>(rank);
+            size_t upper = std::min(lower + 1, times.size() - 1);
+            return times[lower] + (rank - static_cast<double>(lower)) * (times[upper] - times[lower]);
+        };
+
+        stats.min = times.front();
+        stats.median = percentile(0.5);
+        stats.p90 = percentile(0.9);
+        stats.p99 = percentile(0.99);
+        stats.mean = std::accumulate(times.begin(), times.end(), 0.0) / static_cast<double>(times.size());
+        if (times.size() > 1) {
+            double sum = 0.0;
+            for (double t : times) sum += (t - stats.mean) * (t - stats.mean);
+            stats.stddev = std::sqrt(sum / static_cast<double>(times.size() - 1));
+        }
+        return stats;
+    }
+
+    // Per-repetition sums of the hardware counters; a counter that was unavailable in any
+    // repetition stays unavailable.
+    struct CounterTotals {
+        PerfCounterValues sum{0, 0, 0, 0, 0, 0};
+        long long repetitions = 0;
+
+        void add(const PerfCounterValues& values) {
+            for (auto field : {&PerfCounterValues::cycles, &PerfCounterValues::instructions,
+                               &PerfCounterValues::branchMisses, &PerfCounterValues::l1dMisses,
+                               &PerfCounterValues::llcMisses, &PerfCounterValues::dtlbMisses}) {
+                sum.*field = (sum.*field < 0 || values.*field < 0) ? -1 : sum.*field + values.*field;
+            }
+            repetitions++;
+        }
+
+        PerfCounterValues mean() const {
+            PerfCounterValues values;
+            if (repetitions == 0) return values;
+            for (auto field : {&PerfCounterValues::cycles, &PerfCounterValues::instructions,
+                               &PerfCounterValues::branchMisses, &PerfCounterValues::l1dMisses,
+                               &PerfCounterValues::llcMisses, &PerfCounterValues::dtlbMisses}) {
+                values.*field = sum.*field < 0 ? -1 : sum.*field / repetitions;
+            }
+            return values;
+        }
+    };
+
+    static ElementOperations meanOperations(const ElementOperations& total, size_t repetitions) {
+        const long long n = std::max<long long>(static_cast<long long>(repetitions), 1);
+        return {total.copyConstructions / n, total.copyAssignments / n, total.moveConstructions / n,
+                total.moveAssignments / n, total.swaps / n};
+    }
+
+    // Heap use of an extra, untimed call of the merge: the counting operator new is kept
+    // out of the timed call and its hardware counters.
+    template <typename Merge>
+    static AllocationStats measureAllocations(Merge merge) {
+        AllocationTracker::start();
+        auto result = merge();
+        AllocationStats allocations = AllocationTracker::stop();
+        return allocations;  // The result is freed after stop(), as the timed call's is.
+    }
+
+    static AllocationStats meanAllocations(const AllocationStats& total, size_t repetitions) {
+        const long long n = std::max<long long>(static_cast<long long>(repetitions), 1);
+        return {total.allocations / n, total.bytes / n, total.peakBytes};
+    }
+
+    static std::string counterText(long long value) {
+        return value < 0 ? "n/a" : std::to_string(value);
+    }
+
+    static std::string ipcText(double ipc) {
+        if (ipc < 0) return "n/a";
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2) << ipc;
+        return oss.str();
+    }
+
+    static std::string csvCounter(long long value) {
+        return value < 0 ? "" : std::to_string(value);
+    }
+
+    int tableWidth(bool withCounters = false) const {
+        return colWidthScenario_ + colWidthSizeA_ + colWidthSizeB_ + colWidthCase_ + colWidthKey_ + 6 * colWidthTime_ +
+               colWidthReps_ + colWidthComp_ + 6 * colWidthOps_ + 2 * colWidthBytes_ + colWidthStable_ + colWidthResult_ +
+               (withCounters ? 6 * colWidthCount_ + colWidthIpc_ : 0);
+    }
+
     // Column width parameters for the report output table.
     int reportWidth_;
     int colWidthScenario_;
@@ -186,11 +532,21 @@ private:
     int colWidthSizeB_;
     int colWidthCase_;
     int colWidthTime_;
+    int colWidthKey_ = 13;
+    int colWidthReps_ = 6;
+    int colWidthCount_ = 14;
+    int colWidthIpc_ = 6;
+    int colWidthOps_ = 12;
+    int colWidthBytes_ = 14;
     int colWidthComp_;
     int colWidthStable_;
     int colWidthResult_;
 
     std::vector<TestScenario> scenarios_;
+    TimingConfig timing_;
+    PerfCounters counters_;
+    bool verbose_ = true;
+    DatasetCache* datasetCache_ = nullptr;
 };
 
 #endif // ALGORITHM_TESTER_HPP
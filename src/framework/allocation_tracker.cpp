@@ -0,0 +1,120 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Replaces the global operator new / delete to feed AllocationTracker.
+ */
+
+#include "allocation_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+void AllocationTracker::start() {
+    allocations_.store(0, std::memory_order_relaxed);
+    bytes_.store(0, std::memory_order_relaxed);
+    live_.store(0, std::memory_order_relaxed);
+    peak_.store(0, std::memory_order_relaxed);
+    active_.store(true, std::memory_order_seq_cst);
+}
+
+AllocationStats AllocationTracker::stop() {
+    active_.store(false, std::memory_order_seq_cst);
+    return {allocations_.load(std::memory_order_relaxed),
+            bytes_.load(std::memory_order_relaxed),
+            peak_.load(std::memory_order_relaxed)};
+}
+
+namespace {
+
+// Every block starts with a header right before the user pointer: the requested size and
+// the distance back to the start of the underlying malloc / aligned_alloc block.
+struct BlockHeader {
+    std::size_t size;
+    std::size_t offset;
+};
+
+constexpr std::size_t headerSpace = 16;
+static_assert(sizeof(BlockHeader) <= headerSpace, "block header must fit in front of the block");
+
+void* allocate(std::size_t size, std::size_t alignment) noexcept {
+    // The header space is a multiple of the alignment, so the user pointer stays aligned.
+    const std::size_t offset = alignment <= headerSpace ? headerSpace : alignment;
+    void* raw = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+        raw = std::malloc(offset + size);
+    } else {
+        const std::size_t total = (offset + size + alignment - 1) / alignment * alignment;
+        raw = std::aligned_alloc(alignment, total);
+    }
+    if (raw == nullptr) return nullptr;
+
+    auto* user = static_cast<unsigned char*>(raw) + offset;
+    ::new (user - headerSpace) BlockHeader{size, offset};
+    AllocationTracker::onAllocate(static_cast<long long>(size));
+    return user;
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    auto* user = static_cast<unsigned char*>(ptr);
+    const auto* header = reinterpret_cast<const BlockHeader*>(user - headerSpace);
+    AllocationTracker::onDeallocate(static_cast<long long>(header->size));
+    std::free(user - header->offset);
+}
+
+// Throwing forms: retry through the new-handler as the standard operator new does.
+void* allocateOrThrow(std::size_t size, std::size_t alignment) {
+    for (;;) {
+        if (void* ptr = allocate(size, alignment)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
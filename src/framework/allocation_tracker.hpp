@@ -0,0 +1,55 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Heap allocation accounting (count, bytes, peak live bytes) over a measured
+ *              region, via replaced global operator new / delete.
+ */
+
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <atomic>
+
+// Heap usage of one measured region.
+struct AllocationStats {
+    long long allocations = 0;  // Calls to operator new (all forms).
+    long long bytes = 0;        // Bytes requested by those calls.
+    long long peakBytes = 0;    // Maximum of (bytes allocated - bytes freed) since start().
+};
+
+/*
+ * The replacement operators (allocation_tracker.cpp) prefix every block with its size, so
+ * frees are accounted even through the unsized operator delete. They count from all
+ * threads, but only between start() and stop(); regions must not nest. Blocks freed in
+ * the region that were allocated before it lower the live bytes, so peakBytes is the
+ * peak growth of the heap over its size at start().
+ */
+class AllocationTracker {
+public:
+    static void start();
+    static AllocationStats stop();
+
+    // Hooks of the replacement operators.
+    static void onAllocate(long long size) {
+        if (!active_.load(std::memory_order_relaxed)) return;
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(size, std::memory_order_relaxed);
+        long long live = live_.fetch_add(size, std::memory_order_relaxed) + size;
+        long long peak = peak_.load(std::memory_order_relaxed);
+        while (live > peak && !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    static void onDeallocate(long long size) {
+        if (!active_.load(std::memory_order_relaxed)) return;
+        live_.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+private:
+    inline static std::atomic<bool>      active_{false};
+    inline static std::atomic<long long> allocations_{0};
+    inline static std::atomic<long long> bytes_{0};
+    inline static std::atomic<long long> live_{0};
+    inline static std::atomic<long long> peak_{0};
+};
+
+#endif // ALLOCATION_TRACKER_HPP
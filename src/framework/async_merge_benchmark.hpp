@@ -0,0 +1,169 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Demo of the coroutine merge: local producers emit generate_sorted_vectors data
+ *              in random chunks with random delays, a consumer (fast or slow) pulls the merged
+ *              chunks, and the report shows how far the channels filled up.
+ */
+
+#ifndef ASYNC_MERGE_BENCHMARK_HPP
+#define ASYNC_MERGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/async_merge.hpp"
+
+struct AsyncMergeScenario {
+    int         producers;      // Number of input streams (even: each test case gives two).
+    int         streamSize;     // Elements per stream.
+    std::size_t maxChunk;       // Producers send chunks of 1..maxChunk elements.
+    int         maxDelayUs;     // Producer i waits up to (i + 1) * maxDelayUs before each chunk.
+    int         consumerDelayUs; // Consumer waits this long after each merged chunk (slow consumer).
+    std::size_t capacity;       // Channel capacity (chunks).
+};
+
+struct AsyncMergeResult {
+    AsyncMergeScenario scenario;
+    std::size_t        elements;
+    std::size_t        outputChunks;
+    std::size_t        maxQueued;   // Largest number of chunks queued in any channel.
+    double             time;        // ms
+    bool               isCorrect;   // Equal to a stable sort of the streams (in stream order).
+};
+
+class AsyncMergeBenchmark {
+public:
+    void addScenario(const AsyncMergeScenario& scenario) {
+        scenarios_.push_back(scenario);
+    }
+
+    std::vector<AsyncMergeResult> run() {
+        std::vector<AsyncMergeResult> results;
+        for (const auto& scenario : scenarios_) {
+            results.push_back(runScenario(scenario));
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<AsyncMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Async Merge Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(11) << "Producers"
+            << std::setw(12) << "Elements"
+            << std::setw(10) << "MaxChunk"
+            << std::setw(13) << "Delay(us)"
+            << std::setw(15) << "Consumer(us)"
+            << std::setw(10) << "Capacity"
+            << std::setw(11) << "MaxQueued"
+            << std::setw(11) << "OutChunks"
+            << std::setw(11) << "Time(ms)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(11) << res.scenario.producers
+                << std::setw(12) << res.elements
+                << std::setw(10) << res.scenario.maxChunk
+                << std::setw(13) << res.scenario.maxDelayUs
+                << std::setw(15) << res.scenario.consumerDelayUs
+                << std::setw(10) << res.scenario.capacity
+                << std::setw(11) << res.maxQueued
+                << std::setw(11) << res.outputChunks
+                << std::setw(11) << res.time
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Chunk = std::vector<CountingInt>;
+
+    static AsyncTask produce(AsyncExecutor& executor, AsyncChannel<Chunk>& channel, const Chunk& data,
+                             std::size_t maxChunk, int maxDelayUs, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<std::size_t> size(1, maxChunk);
+        std::uniform_int_distribution<int> delay(0, maxDelayUs);
+        for (std::size_t pos = 0; pos < data.size();) {
+            std::size_t count = std::min(size(rng), data.size() - pos);
+            co_await executor.sleep_for(std::chrono::microseconds(delay(rng)));
+            co_await channel.send(Chunk(data.begin() + pos, data.begin() + pos + count));
+            pos += count;
+        }
+        channel.close();
+    }
+
+    static AsyncTask consume(AsyncExecutor& executor, AsyncStream<Chunk> merged, int delayUs,
+                             Chunk& output, std::size_t& chunks) {
+        while (auto chunk = co_await merged.next()) {
+            output.insert(output.end(), chunk->begin(), chunk->end());
+            ++chunks;
+            if (delayUs > 0) co_await executor.sleep_for(std::chrono::microseconds(delayUs));
+        }
+    }
+
+    static AsyncMergeResult runScenario(const AsyncMergeScenario& scenario) {
+        std::vector<Chunk> streams;
+        for (int i = 0; i < scenario.producers; i += 2) {
+            MergeTestCase testCase = generate_numbered_sorted_vectors(i / 2, scenario.streamSize, scenario.streamSize,
+                                                                      CornerCaseType::RANDOM, 0, 1000000, 2, 3, 16, {});
+            streams.push_back(std::move(testCase.a));
+            streams.push_back(std::move(testCase.b));
+        }
+        streams.resize(scenario.producers);
+        // Number the elements across all streams, so the check also sees the order of equal values.
+        int index = 0;
+        for (auto& stream : streams) {
+            for (auto& element : stream) element.index = index++;
+        }
+
+        Chunk expected;
+        for (const auto& stream : streams) expected.insert(expected.end(), stream.begin(), stream.end());
+        std::stable_sort(expected.begin(), expected.end());
+
+        AsyncExecutor executor;
+        std::vector<std::unique_ptr<AsyncChannel<Chunk>>> channels;
+        std::vector<AsyncStream<Chunk>> inputs;
+        for (int i = 0; i < scenario.producers; ++i) {
+            channels.push_back(std::make_unique<AsyncChannel<Chunk>>(executor, scenario.capacity));
+            inputs.push_back(async_receive_all(*channels.back()));
+        }
+
+        Chunk output;
+        std::size_t chunks = 0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < scenario.producers; ++i) {
+            executor.spawn(produce(executor, *channels[i], streams[i], scenario.maxChunk,
+                                   (i + 1) * scenario.maxDelayUs, static_cast<unsigned>(i) + 1));
+        }
+        executor.spawn(consume(executor, async_merge(std::move(inputs), scenario.maxChunk),
+                               scenario.consumerDelayUs, output, chunks));
+        executor.run();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::size_t maxQueued = 0;
+        for (const auto& channel : channels) maxQueued = std::max(maxQueued, channel->high_water());
+
+        bool isCorrect = output.size() == expected.size() &&
+            std::equal(output.begin(), output.end(), expected.begin(), [](const CountingInt& x, const CountingInt& y) {
+                return x.value == y.value && x.source == y.source && x.index == y.index;
+            });
+
+        return {scenario, expected.size(), chunks, maxQueued,
+                std::chrono::duration<double, std::milli>(end - start).count(), isCorrect};
+    }
+
+    std::vector<AsyncMergeScenario> scenarios_;
+};
+
+#endif // ASYNC_MERGE_BENCHMARK_HPP
@@ -0,0 +1,174 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Throughput benchmark for many small independent merges: the container API
+ *              called once per merge versus the batch API on 1..N threads.
+ */
+
+#ifndef BATCH_MERGE_BENCHMARK_HPP
+#define BATCH_MERGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/batch_merge.hpp"
+
+struct BatchMergeResult {
+    std::string algorithm;
+    std::string mode;       // "per-call" (container API) or "batch".
+    std::size_t threads;
+    std::size_t jobs;
+    double      time;       // Whole batch (ms).
+    double      mergesPerSecond;
+    double      elementsPerSecond;
+    bool        isCorrect;  // Every output equals std::merge of its inputs.
+};
+
+class BatchMergeBenchmark {
+public:
+    BatchMergeBenchmark(std::size_t jobs, int minSize, int maxSize)
+        : jobCount_(jobs), minSize_(minSize), maxSize_(maxSize) {}
+
+    std::vector<BatchMergeResult> run() {
+        generate();
+
+        std::vector<std::size_t> threadCounts;
+        const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t t = 1; t < hardware; t *= 2) threadCounts.push_back(t);
+        threadCounts.push_back(hardware);
+
+        std::vector<BatchMergeResult> results;
+        runAlgorithm<TwoWayMergeKernel>("TwoWayMerge", threadCounts, results,
+            [](auto& a, auto& b) { return two_way_merge(a, b); });
+        runAlgorithm<HwangLinStaticMergeKernel>("HwangLinStaticMerge", threadCounts, results,
+            [](auto& a, auto& b) { return hwang_lin_static_merge(a, b); });
+        runAlgorithm<HwangLinStaticKutznerMergeKernel>("HwangLinStaticKutznerMerge", threadCounts, results,
+            [](auto& a, auto& b) { return hwang_lin_static_kutzner_merge(a, b); });
+        runAlgorithm<SimpleKimKutznerMergeKernel>("SimpleKimKutznerMerge", threadCounts, results,
+            [](auto& a, auto& b) { return simple_kim_kutzner_merge(a, b); });
+        runAlgorithm<UnstableCoreKimKutznerMergeKernel>("UnstableCoreKimKutznerMerge", threadCounts, results,
+            [](auto& a, auto& b) { return unstable_core_kim_kutzner_merge(a, b); });
+        runAlgorithm<FractileInsertionMergeKernel>("FractileInsertionMerge", threadCounts, results,
+            [](auto& a, auto& b) { return fractile_insertion_merge(a, b); });
+        return results;
+    }
+
+    std::string generateReport(const std::vector<BatchMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Batch Merge Report (" << jobCount_ << " merges, |A|,|B| in [" << minSize_ << ", " << maxSize_ << "]):\n"
+            << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(10) << "Mode"
+            << std::setw(9)  << "Threads"
+            << std::setw(13) << "Time(ms)"
+            << std::setw(16) << "Merges/s"
+            << std::setw(16) << "MElements/s"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.algorithm
+                << std::setw(10) << res.mode
+                << std::setw(9)  << res.threads
+                << std::setw(13) << res.time
+                << std::setw(16) << std::setprecision(0) << res.mergesPerSecond
+                << std::setw(16) << std::setprecision(3) << res.elementsPerSecond / 1e6
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Value = std::int32_t;
+
+    // All inputs live in one arena and all outputs in another; jobs are views into them.
+    void generate() {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> size(minSize_, maxSize_);
+        std::uniform_int_distribution<Value> value(0, 1000000);
+
+        std::vector<std::size_t> sizes(2 * jobCount_);
+        std::size_t total = 0;
+        for (auto& s : sizes) total += (s = static_cast<std::size_t>(size(rng)));
+
+        inputs_.resize(total);
+        outputs_.assign(total, 0);
+        expected_.resize(total);
+        jobs_.clear();
+
+        std::size_t offset = 0;
+        for (std::size_t j = 0; j < jobCount_; ++j) {
+            std::size_t m = sizes[2 * j];
+            std::size_t n = sizes[2 * j + 1];
+            Value* a = inputs_.data() + offset;
+            Value* b = a + m;
+            std::generate(a, b + n, [&] { return value(rng); });
+            std::sort(a, b);
+            std::sort(b, b + n);
+            std::merge(a, b, b, b + n, expected_.data() + offset);
+            jobs_.push_back({{a, m}, {b, n}, {outputs_.data() + offset, m + n}});
+            offset += m + n;
+        }
+    }
+
+    template <typename Kernel, typename ContainerMerge>
+    void runAlgorithm(const std::string& name, const std::vector<std::size_t>& threadCounts,
+                      std::vector<BatchMergeResult>& results, ContainerMerge containerMerge) {
+        // Baseline: one container-API call per merge (input copies, result allocation).
+        std::fill(outputs_.begin(), outputs_.end(), 0);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& job : jobs_) {
+            std::vector<Value> a(job.a.begin(), job.a.end());
+            std::vector<Value> b(job.b.begin(), job.b.end());
+            std::vector<Value> r = containerMerge(a, b);
+            std::copy(r.begin(), r.end(), job.out.begin());
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        results.push_back(makeResult(name, "per-call", 1, start, end));
+
+        for (std::size_t threads : threadCounts) {
+            ThreadPool pool(threads);
+            BatchMerger<Value, Kernel> merger(pool);
+            merger.run(jobs_); // warm-up: sizes the scratch buffers and task tables
+
+            std::fill(outputs_.begin(), outputs_.end(), 0);
+            start = std::chrono::high_resolution_clock::now();
+            merger.run(jobs_);
+            end = std::chrono::high_resolution_clock::now();
+            results.push_back(makeResult(name, "batch", threads, start, end));
+        }
+    }
+
+    template <typename TimePoint>
+    BatchMergeResult makeResult(const std::string& name, const std::string& mode, std::size_t threads,
+                                TimePoint start, TimePoint end) const {
+        double time = std::chrono::duration<double, std::milli>(end - start).count();
+        double seconds = time / 1000.0;
+        return {name, mode, threads, jobCount_, time,
+                static_cast<double>(jobCount_) / seconds,
+                static_cast<double>(outputs_.size()) / seconds,
+                outputs_ == expected_};
+    }
+
+    std::size_t                 jobCount_;
+    int                         minSize_;
+    int                         maxSize_;
+    std::vector<Value>          inputs_;
+    std::vector<Value>          outputs_;
+    std::vector<Value>          expected_;
+    std::vector<MergeJob<Value>> jobs_;
+};
+
+#endif // BATCH_MERGE_BENCHMARK_HPP
@@ -7,10 +7,29 @@
 #define COUNTING_INT_HPP
 
 #include <iostream>
+#include <utility>
 
 // Enum for indicating the source slice.
 enum class Slice { A, B };
 
+// Element copies, moves and swaps performed by the calling thread.
+struct ElementOperations {
+    long long copyConstructions = 0;
+    long long copyAssignments = 0;
+    long long moveConstructions = 0;
+    long long moveAssignments = 0;
+    long long swaps = 0;
+
+    ElementOperations& operator+=(const ElementOperations& other) {
+        copyConstructions += other.copyConstructions;
+        copyAssignments += other.copyAssignments;
+        moveConstructions += other.moveConstructions;
+        moveAssignments += other.moveAssignments;
+        swaps += other.swaps;
+        return *this;
+    }
+};
+
 class CountingInt {
 public:
     int value;      // The integer value of the element.
@@ -18,11 +37,45 @@ public:
     int index;      // The index of the element in its input sequence.
 
     inline static long long comparisons = 0; // Static counter for tracking the number of comparisons.
+    inline static thread_local ElementOperations operations; // Copies, moves and swaps of this thread.
 
     CountingInt(int v = 0, Slice s = Slice::A, int idx = 0) : value(v), source(s), index(idx) {}
 
+    CountingInt(const CountingInt& other) : value(other.value), source(other.source), index(other.index) {
+        ++operations.copyConstructions;
+    }
+
+    CountingInt(CountingInt&& other) noexcept : value(other.value), source(other.source), index(other.index) {
+        ++operations.moveConstructions;
+    }
+
+    CountingInt& operator=(const CountingInt& other) {
+        value = other.value;
+        source = other.source;
+        index = other.index;
+        ++operations.copyAssignments;
+        return *this;
+    }
+
+    CountingInt& operator=(CountingInt&& other) noexcept {
+        value = other.value;
+        source = other.source;
+        index = other.index;
+        ++operations.moveAssignments;
+        return *this;
+    }
+
+    // Found by ADL from std::iter_swap, std::rotate and friends: one swap, not three moves.
+    friend void swap(CountingInt& lhs, CountingInt& rhs) noexcept {
+        std::swap(lhs.value, rhs.value);
+        std::swap(lhs.source, rhs.source);
+        std::swap(lhs.index, rhs.index);
+        ++operations.swaps;
+    }
+
     static void resetCounter() {
         comparisons = 0;
+        operations = ElementOperations{};
     }
 };
 
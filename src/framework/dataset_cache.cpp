@@ -0,0 +1,241 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Implements DatasetCache: binary dataset files, read through mmap where available.
+ */
+
+#include "dataset_cache.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DATASET_CACHE_MMAP 1
+#endif
+
+#ifdef __linux__
+#include <linux/magic.h>
+#include <sys/vfs.h>
+#endif
+
+namespace {
+
+const char fileMagic[8] = {'E', 'M', 'D', 'S', 'E', 'T', '0', '1'};
+
+struct FileHeader {
+    char          magic[8];
+    std::uint64_t sizeA;
+    std::uint64_t sizeB;
+    std::uint64_t keyLength;
+};
+
+// One element on disk: the value and where it comes from.
+struct Element {
+    std::int32_t  value;
+    std::uint32_t origin;  // Index in its input; top bit set for B.
+};
+
+constexpr std::uint32_t originB = std::uint32_t{1} << 31;
+
+std::uint64_t padded(std::uint64_t bytes) {
+    return (bytes + 7) / 8 * 8;
+}
+
+// Parses a whole dataset file; false if it is not the dataset of `key`.
+bool decode(const unsigned char* bytes, std::uint64_t size, const std::string& key, MergeTestCase& test_case) {
+    FileHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.keyLength != key.size()) {
+        return false;
+    }
+    const std::uint64_t keyOffset = sizeof(header);
+    const std::uint64_t dataOffset = keyOffset + padded(header.keyLength);
+    const std::uint64_t total = header.sizeA + header.sizeB;
+    if (std::memcmp(bytes + keyOffset, key.data(), key.size()) != 0 ||
+        size != dataOffset + 2 * total * sizeof(Element)) {
+        return false;
+    }
+
+    // The data offset is a multiple of 8 and the mapping is page aligned.
+    const auto* elements = reinterpret_cast<const Element*>(bytes + dataOffset);
+    auto unpack = [&](std::vector<CountingInt>& out, std::uint64_t count) {
+        out.clear();
+        out.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i, ++elements) {
+            out.emplace_back(elements->value, (elements->origin & originB) ? Slice::B : Slice::A,
+                             static_cast<int>(elements->origin & ~originB));
+        }
+    };
+    unpack(test_case.a, header.sizeA);
+    unpack(test_case.b, header.sizeB);
+    unpack(test_case.result, total);
+    return true;
+}
+
+} // namespace
+
+DatasetCache::DatasetCache(const std::string& directory, int datasetsPerScenario, std::size_t memoryBudget,
+                           bool requireTmpfs)
+    : directory_(directory), datasetsPerScenario_(datasetsPerScenario), memoryBudget_(memoryBudget) {
+    if (datasetsPerScenario < 0) {
+        throw std::invalid_argument("number of datasets per scenario must not be negative");
+    }
+    if (memoryBudget_ == 0) {
+#ifdef DATASET_CACHE_MMAP
+        long pages = sysconf(_SC_PHYS_PAGES);
+        long pageSize = sysconf(_SC_PAGE_SIZE);
+        memoryBudget_ = pages > 0 && pageSize > 0 ? static_cast<std::size_t>(pages) * pageSize / 2 : std::size_t{1} << 30;
+#else
+        memoryBudget_ = std::size_t{1} << 30;
+#endif
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error || !std::filesystem::is_directory(directory_)) {
+        throw std::runtime_error("unable to create dataset cache directory " + directory_);
+    }
+
+    if (requireTmpfs) {
+#ifdef __linux__
+        struct statfs info;
+        if (statfs(directory_.c_str(), &info) != 0 ||
+            (info.f_type != TMPFS_MAGIC && info.f_type != RAMFS_MAGIC)) {
+            throw std::runtime_error("dataset cache directory " + directory_ + " is not on tmpfs");
+        }
+#else
+        throw std::runtime_error("pinning the dataset cache to tmpfs needs Linux");
+#endif
+    }
+}
+
+std::shared_ptr<const MergeTestCase> DatasetCache::load(const TestScenario& scenario, int run) {
+    const int dataset = datasetsPerScenario_ > 0 ? run % datasetsPerScenario_ : run;
+    const std::string key = keyOf(scenario, dataset);
+    auto found = inMemory_.find(key);
+    if (found != inMemory_.end()) {
+        ++shared_;
+        return found->second;
+    }
+    const std::uint64_t hash = hashKey(key);
+
+    std::ostringstream name;
+    name << scenario.sizeA << "_" << scenario.sizeB << "_" << toString(scenario.caseType) << "_"
+         << std::hex << std::setw(16) << std::setfill('0') << hash << ".dataset";
+    const std::string path = (std::filesystem::path(directory_) / name.str()).string();
+
+    auto test_case = std::make_shared<MergeTestCase>();
+    if (read(path, key, *test_case)) {
+        ++mapped_;
+    } else {
+        // The same data as generateTestCase gives for the run, so the cache does not change it.
+        *test_case = generateTestCase(scenario, dataset);
+        write(path, key, *test_case);
+        ++generated_;
+    }
+
+    // Kept while they fit, not evicted: the algorithms of a run go through the datasets in
+    // the same order one after the other, so any eviction order would thrash.
+    const std::size_t bytes = (test_case->a.size() + test_case->b.size() + test_case->result.size()) *
+                              sizeof(CountingInt);
+    if (memoryUsed_ + bytes <= memoryBudget_) {
+        memoryUsed_ += bytes;
+        inMemory_.emplace(key, test_case);
+    }
+    return test_case;
+}
+
+std::string DatasetCache::keyOf(const TestScenario& scenario, int dataset) const {
+    return scenarioKey(scenario) + " seed=" + std::to_string(sorted_vectors_seed()) +
+           " dataset=" + std::to_string(dataset);
+}
+
+bool DatasetCache::read(const std::string& path, const std::string& key, MergeTestCase& test_case) const {
+#ifdef DATASET_CACHE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+
+    madvise(data, size, MADV_SEQUENTIAL);
+    bool ok = decode(static_cast<const unsigned char*>(data), size, key, test_case);
+    munmap(data, size);
+    return ok;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    std::vector<std::uint64_t> data((static_cast<std::size_t>(in.tellg()) + 7) / 8);  // 8-byte aligned.
+    const auto size = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size))) return false;
+    return decode(reinterpret_cast<const unsigned char*>(data.data()), size, key, test_case);
+#endif
+}
+
+void DatasetCache::write(const std::string& path, const std::string& key, const MergeTestCase& test_case) const {
+    // Written next to the target and renamed, so a reader never sees a partial file.
+    const std::string partial = path + ".partial";
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("unable to write dataset " + partial);
+        }
+
+        FileHeader header;
+        std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+        header.sizeA = test_case.a.size();
+        header.sizeB = test_case.b.size();
+        header.keyLength = key.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.data(), static_cast<std::streamsize>(key.size()));
+        const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>(padded(key.size()) - key.size()));
+
+        std::vector<Element> buffer;
+        buffer.reserve(1 << 16);
+        auto pack = [&](const std::vector<CountingInt>& values) {
+            for (const auto& x : values) {
+                buffer.push_back({x.value, static_cast<std::uint32_t>(x.index) | (x.source == Slice::B ? originB : 0)});
+                if (buffer.size() == buffer.capacity()) {
+                    out.write(reinterpret_cast<const char*>(buffer.data()),
+                              static_cast<std::streamsize>(buffer.size() * sizeof(Element)));
+                    buffer.clear();
+                }
+            }
+        };
+        pack(test_case.a);
+        pack(test_case.b);
+        pack(test_case.result);
+        out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Element)));
+
+        if (!out.flush()) {
+            out.close();
+            std::filesystem::remove(partial);
+            throw std::runtime_error("unable to write dataset " + partial);
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(partial, path, error);
+    if (error) {
+        std::filesystem::remove(partial, error);
+        throw std::runtime_error("unable to write dataset " + path);
+    }
+}
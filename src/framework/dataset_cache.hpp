@@ -0,0 +1,89 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: On-disk cache of generated test cases (inputs and expected result), memory
+ *              mapped on later runs and shared by all algorithms of a run.
+ */
+
+#ifndef DATASET_CACHE_HPP
+#define DATASET_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include "generate_sorted_vectors.hpp"
+#include "test_scenarious.hpp"
+
+/*
+ * Every dataset is one binary file named after its key: the scenario (sizes, case, value
+ * range, block sizes, keys, distribution parameters), the generator seed and the dataset
+ * number. Its data depends on nothing else (see generate_numbered_sorted_vectors), so a
+ * file written by one algorithm, or by an earlier run with the same --seed, is exactly
+ * what generating again would produce. Missing, stale or damaged files are regenerated.
+ *
+ * Loaded datasets stay in memory, shared by all algorithms of the run, as long as they fit
+ * in the memory budget; the ones beyond it are mapped and decoded again on every load.
+ *
+ * File layout (native byte order): the header, the key text padded to 8 bytes, then A, B
+ * and the result as (int32 value, uint32 origin) pairs, where origin is the index in the
+ * input with the top bit set for B.
+ */
+class DatasetCache {
+public:
+    // Default directory of a cache pinned to tmpfs.
+    static constexpr const char* tmpfsDirectory = "/dev/shm/efficient_merge_datasets";
+
+    // Caches in `directory` (created if missing). Every run of a scenario gets its own
+    // dataset, as without the cache, unless `datasetsPerScenario` (> 0) makes the runs
+    // cycle through fewer. `memoryBudget` bytes of datasets are kept in memory (0: half of
+    // the physical memory). With `requireTmpfs` the directory must be on tmpfs, so that
+    // mapping a dataset never waits for the disk.
+    // Throws std::runtime_error if the directory cannot be used, std::invalid_argument
+    // for a negative number of datasets.
+    explicit DatasetCache(const std::string& directory, int datasetsPerScenario = 0,
+                          std::size_t memoryBudget = 0, bool requireTmpfs = false);
+
+    // Test case of the given run of the scenario: from memory if it is there, mapped from
+    // its file if it was cached, otherwise generated and written.
+    // Throws std::runtime_error if a new dataset cannot be written.
+    std::shared_ptr<const MergeTestCase> load(const TestScenario& scenario, int run);
+
+    const std::string& getDirectory() const {
+        return directory_;
+    }
+
+    // Datasets per scenario, 0 for one per run.
+    int getDatasetsPerScenario() const {
+        return datasetsPerScenario_;
+    }
+
+    // Loads served by generating (and writing) a dataset, by mapping its file and from memory.
+    long long getGenerated() const {
+        return generated_;
+    }
+
+    long long getMapped() const {
+        return mapped_;
+    }
+
+    long long getShared() const {
+        return shared_;
+    }
+
+private:
+    std::string keyOf(const TestScenario& scenario, int dataset) const;
+    bool read(const std::string& path, const std::string& key, MergeTestCase& test_case) const;
+    void write(const std::string& path, const std::string& key, const MergeTestCase& test_case) const;
+
+    std::string directory_;
+    int         datasetsPerScenario_;
+    std::size_t memoryBudget_;
+    std::size_t memoryUsed_ = 0;
+    std::map<std::string, std::shared_ptr<const MergeTestCase>> inMemory_;  // By key.
+    long long   generated_ = 0;
+    long long   mapped_ = 0;
+    long long   shared_ = 0;
+};
+
+#endif // DATASET_CACHE_HPP
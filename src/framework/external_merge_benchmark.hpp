@@ -0,0 +1,192 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Benchmark driver for the external (mmap-based) merge: generates sorted run
+ *              files locally, merges them and verifies the merged file.
+ */
+
+#ifndef EXTERNAL_MERGE_BENCHMARK_HPP
+#define EXTERNAL_MERGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../algorithms/external_merge.hpp"
+
+struct ExternalMergeShape {
+    std::vector<std::uint64_t> runSizes; // Number of elements in each run.
+    std::uint64_t              maxGap;   // Keys of the largest run grow by a random gap in [0, maxGap];
+                                         // smaller runs use proportionally larger gaps to span the same range.
+    std::uint64_t              burst = 0; // When non-zero, runs take turns in key windows of `burst` elements
+                                          // (like BLOCK_INTERLEAVE), so whole pages can be copied untouched.
+};
+
+struct ExternalMergeResult {
+    ExternalMergeShape shape;
+    double             generateTime; // Writing the run files (ms).
+    double             mergeTime;    // external_merge (ms).
+    ExternalMergeStats stats;
+    bool               isCorrect;    // Output equals a reference merge of the runs.
+};
+
+class ExternalMergeBenchmark {
+public:
+    explicit ExternalMergeBenchmark(std::string directory) : directory_(std::move(directory)) {}
+
+    void addShape(const ExternalMergeShape& shape) {
+        shapes_.push_back(shape);
+    }
+
+    std::vector<ExternalMergeResult> run() {
+        std::vector<ExternalMergeResult> results;
+        for (const auto& shape : shapes_) {
+            std::vector<std::string> inputs;
+            std::uint64_t largest = 1;
+            std::uint64_t smallest = ~std::uint64_t{0};
+            for (auto size : shape.runSizes) {
+                largest = std::max(largest, size);
+                smallest = std::min(smallest, std::max<std::uint64_t>(size, 1));
+            }
+            // Width of a burst window: large enough for any run's burst.
+            std::uint64_t window = shape.burst * (shape.maxGap * largest / smallest) + 1;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (std::size_t r = 0; r < shape.runSizes.size(); ++r) {
+                inputs.push_back(path("run_" + std::to_string(r) + ".bin"));
+                std::uint64_t gap = shape.maxGap * largest / std::max<std::uint64_t>(shape.runSizes[r], 1);
+                writeRun(inputs.back(), shape.runSizes[r], gap, r + 1,
+                         shape.burst, window, r, shape.runSizes.size());
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double generateTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+            const std::string output = path("merged.bin");
+            start = std::chrono::high_resolution_clock::now();
+            ExternalMergeStats stats = external_merge<std::int64_t>(inputs, output);
+            end = std::chrono::high_resolution_clock::now();
+            double mergeTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+            bool isCorrect = verify(output, inputs);
+            results.push_back({shape, generateTime, mergeTime, stats, isCorrect});
+
+            for (const auto& input : inputs) std::filesystem::remove(input);
+            std::filesystem::remove(output);
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<ExternalMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "External Merge Report (" << directory_ << "):\n" << separator << "\n";
+        oss << std::left
+            << std::setw(6)  << "Runs"
+            << std::setw(14) << "Elements"
+            << std::setw(10) << "MaxGap"
+            << std::setw(10) << "Burst"
+            << std::setw(14) << "Generate(ms)"
+            << std::setw(12) << "Merge(ms)"
+            << std::setw(10) << "MB/s"
+            << std::setw(10) << "Bulk(%)"
+            << std::setw(12) << "BulkCalls"
+            << std::setw(12) << "Kernel(MB)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            double megabytes = static_cast<double>(res.stats.elements * sizeof(std::int64_t)) / (1 << 20);
+            oss << std::left
+                << std::setw(6)  << res.shape.runSizes.size()
+                << std::setw(14) << res.stats.elements
+                << std::setw(10) << res.shape.maxGap
+                << std::setw(10) << res.shape.burst
+                << std::setw(14) << res.generateTime
+                << std::setw(12) << res.mergeTime
+                << std::setw(10) << megabytes / (res.mergeTime / 1000.0)
+                << std::setw(10) << (res.stats.elements ? 100.0 * res.stats.bulk_elements / res.stats.elements : 0.0)
+                << std::setw(12) << res.stats.bulk_calls
+                << std::setw(12) << static_cast<double>(res.stats.kernel_copy_bytes) / (1 << 20)
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    std::string path(const std::string& name) const {
+        return (std::filesystem::path(directory_) / name).string();
+    }
+
+    // Writes a sorted run of `size` int64 keys as cumulative random gaps, in bounded chunks
+    // so that runs larger than RAM can be generated. With bursts, the i-th burst of run r
+    // lives in key window i * runs + r.
+    static void writeRun(const std::string& file, std::uint64_t size, std::uint64_t maxGap, std::uint64_t seed,
+                         std::uint64_t burst, std::uint64_t window, std::uint64_t run, std::uint64_t runs) {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("ExternalMergeBenchmark: unable to open " + file);
+        }
+
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<std::uint64_t> gap(0, maxGap);
+        std::vector<std::int64_t> chunk;
+        chunk.reserve(1 << 16);
+
+        std::int64_t key = 0;
+        for (std::uint64_t i = 0; i < size; ++i) {
+            if (burst != 0 && i % burst == 0) {
+                key = static_cast<std::int64_t>(((i / burst) * runs + run) * window);
+            }
+            key += static_cast<std::int64_t>(gap(rng));
+            chunk.push_back(key);
+            if (chunk.size() == chunk.capacity() || i + 1 == size) {
+                out.write(reinterpret_cast<const char*>(chunk.data()),
+                          static_cast<std::streamsize>(chunk.size() * sizeof(std::int64_t)));
+                chunk.clear();
+            }
+        }
+    }
+
+    // Compares the output element by element with a reference k-way merge of the mapped
+    // runs (a heap of cursors, so runs larger than RAM are fine). Unlike a check of order and
+    // size, this also catches a merge that drops one element and duplicates another.
+    static bool verify(const std::string& file, const std::vector<std::string>& inputs) {
+        MappedRun<std::int64_t> merged(file);
+        std::vector<std::unique_ptr<MappedRun<std::int64_t>>> runs;
+        for (const auto& input : inputs) {
+            runs.push_back(std::make_unique<MappedRun<std::int64_t>>(input));
+        }
+
+        using Cursor = std::pair<std::int64_t, std::size_t>;  // Next key, run.
+        std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+        std::vector<std::size_t> positions(runs.size(), 0);
+        for (std::size_t r = 0; r < runs.size(); ++r) {
+            if (runs[r]->size() > 0) heap.push({runs[r]->data()[0], r});
+        }
+
+        std::size_t i = 0;
+        for (; !heap.empty(); ++i) {
+            auto [key, r] = heap.top();
+            heap.pop();
+            if (i >= merged.size() || merged.data()[i] != key) return false;
+            if (++positions[r] < runs[r]->size()) heap.push({runs[r]->data()[positions[r]], r});
+        }
+        return i == merged.size();
+    }
+
+    std::string directory_;
+    std::vector<ExternalMergeShape> shapes_;
+};
+
+#endif // EXTERNAL_MERGE_BENCHMARK_HPP
@@ -5,13 +5,227 @@
 
 #include "generate_sorted_vectors.hpp"
 #include <algorithm>
-#include <ctime>
-#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
 #include <vector>
 #include "counting_int.hpp"
+#include "../algorithms/merge_select.hpp"
 
-inline int rand_in_range(int minVal, int maxVal) {
-    return minVal + std::rand() % (maxVal - minVal + 1);
+namespace {
+
+std::uint64_t generator_seed = 0;
+bool seeded = false;
+unsigned int generator_threads = 0;  // 0: std::thread::hardware_concurrency().
+
+// Elements per chunk of the parallel passes. Fixed, so that the sums, and with them the
+// data, do not depend on the number of threads.
+constexpr std::size_t chunk_size = 1 << 16;
+
+// SplitMix64 finalizer.
+inline std::uint64_t mix64(std::uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Counter-based generator: draw(i) is the i-th output of a SplitMix64 sequence keyed by
+// (seed, stream), so any element can be drawn by any thread in any order.
+class CounterRng {
+public:
+    CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key_(mix64(seed + mix64(stream + 0x9E3779B97F4A7C15ULL))) {}
+
+    std::uint64_t draw(std::uint64_t i) const {
+        return mix64(key_ + (i + 1) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    // Standard exponential variate from draw(i): -log(u) with u uniform in (0, 1].
+    double exponential(std::uint64_t i) const {
+        double u = static_cast<double>((draw(i) >> 11) + 1) * 0x1.0p-53;
+        return -std::log(u);
+    }
+
+private:
+    std::uint64_t key_;
+};
+
+void ensure_seeded() {
+    if (!seeded) {
+        std::random_device device;
+        auto ticks = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        seed_sorted_vectors(mix64(ticks ^ (static_cast<std::uint64_t>(device()) << 32)));
+    }
+}
+
+// Runs body(chunk) for chunk = 0 .. chunks - 1 on up to generator_threads threads.
+template <typename Body>
+void for_each_chunk(std::size_t chunks, Body body) {
+    std::size_t threads = generator_threads != 0 ? generator_threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, chunks);
+    if (threads <= 1) {
+        for (std::size_t c = 0; c < chunks; ++c) body(c);
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t c = next++; c < chunks; c = next++) body(c);
+    };
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+}
+
+/*
+ * Writes value(S_1, S_T), ..., value(S_n, S_T) to out[0..n) with the given source slice and
+ * indices 0..n-1, where S_k = term(0) + ... + term(k - 1) and T >= n is the number of terms.
+ * The terms are non-negative and `value` is non-decreasing in its first argument, so the
+ * output is sorted. The chunk sums are combined in chunk order and every chunk ends exactly
+ * at the next chunk's offset (same additions in both passes), so the output is the same
+ * for any number of threads and sorted exactly, also across chunk boundaries.
+ */
+template <typename Term, typename Value>
+void fill_prefix_sums(CountingInt* out, std::size_t n, std::size_t terms, Slice source, Term term, Value value) {
+    if (n == 0) return;
+    const std::size_t chunks = (terms + chunk_size - 1) / chunk_size;
+
+    // Pass 1: sum of every chunk. Most test cases fit in one chunk: no allocation then.
+    double single_chunk[2] = {0.0, 0.0};
+    std::vector<double> chunk_offsets;
+    double* offset = single_chunk;
+    if (chunks > 1) {
+        chunk_offsets.assign(chunks + 1, 0.0);
+        offset = chunk_offsets.data();
+    }
+    for_each_chunk(chunks, [&](std::size_t c) {
+        double sum = 0.0;
+        for (std::size_t k = c * chunk_size, end = std::min(terms, k + chunk_size); k < end; ++k) {
+            sum += term(k);
+        }
+        offset[c + 1] = sum;
+    });
+    for (std::size_t c = 0; c < chunks; ++c) {
+        offset[c + 1] += offset[c];
+    }
+    const double total = offset[chunks];
+
+    // Pass 2: the values.
+    for_each_chunk(chunks, [&](std::size_t c) {
+        double local = 0.0;
+        for (std::size_t k = c * chunk_size, end = std::min(n, (c + 1) * chunk_size); k < end; ++k) {
+            local += term(k);
+            out[k].value = value(offset[c] + local, total);
+            out[k].source = source;
+            out[k].index = static_cast<int>(k);
+        }
+    });
+}
+
+// Sorted uniform spacings: with E_0..E_n standard exponential, S_1/S_(n+1) <= ... <=
+// S_n/S_(n+1) are distributed as the order statistics of n uniforms on (0, 1). Writes
+// to out[0..n) sorted(map(u_1), ..., map(u_n)) for a non-decreasing map; E_k is draw
+// k + first_draw of rng.
+template <typename Map>
+void fill_sorted_unit(CountingInt* out, std::size_t n, Slice source, const CounterRng& rng, Map map,
+                      std::uint64_t first_draw = 0) {
+    fill_prefix_sums(out, n, n + 1, source,
+                     [&](std::size_t k) { return rng.exponential(first_draw + k); },
+                     [&](double prefix, double total) { return map(prefix / total); });
+}
+
+// n sorted values, independent and uniform on [lo, hi].
+void fill_sorted_uniform(CountingInt* out, std::size_t n, int lo, int hi, Slice source,
+                         const CounterRng& rng, std::uint64_t first_draw = 0) {
+    if (hi < lo) hi = lo;
+    const double width = static_cast<double>(hi) - static_cast<double>(lo) + 1.0;
+    fill_sorted_unit(out, n, source, rng, [&](double u) {
+        auto value = static_cast<long long>(lo) + static_cast<long long>(u * width);
+        return static_cast<int>(std::min<long long>(value, hi));
+    }, first_draw);
+}
+
+// Uniform on [0, 1) from one draw; standard normal from two (Box-Muller).
+inline double unit(std::uint64_t x) {
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+inline double standard_normal(const CounterRng& rng, std::uint64_t i) {
+    double u = 1.0 - unit(rng.draw(2 * i));  // (0, 1]
+    double v = unit(rng.draw(2 * i + 1));
+    return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * 3.14159265358979323846 * v);
+}
+
+// Running sums far beyond the value range saturate instead of wrapping around.
+inline int saturate(double value) {
+    return static_cast<int>(std::clamp(value, static_cast<double>(INT_MIN), static_cast<double>(INT_MAX)));
+}
+
+// Key k of D evenly spaced keys over [lo, hi], increasing in k.
+inline int spaced_key(int k, int keys, int lo, int hi) {
+    if (keys == 1) return lo;
+    return lo + static_cast<int>(static_cast<long long>(k) * (static_cast<long long>(hi) - lo) / (keys - 1));
+}
+
+/*
+ * Cumulative Zipf(s) weights of D keys in value order. The popularity rank of key k is
+ * 1 + (k * stride) mod D with stride coprime to D (near D / golden ratio), which scatters
+ * the popular keys over the range instead of piling them up at randomMin.
+ */
+std::vector<double> zipf_cdf(int keys, double exponent) {
+    auto stride = static_cast<long long>(keys * 0.6180339887) | 1;
+    while (std::gcd(stride, static_cast<long long>(keys)) != 1) stride += 2;
+
+    std::vector<double> cdf(keys);
+    double sum = 0.0;
+    for (int k = 0; k < keys; ++k) {
+        long long rank = 1 + (k * stride) % keys;
+        sum += 1.0 / std::pow(static_cast<double>(rank), exponent);
+        cdf[k] = sum;
+    }
+    for (auto& c : cdf) c /= sum;
+    return cdf;
+}
+
+// Stable merge of the sorted inputs into result (pre-sized), in pieces cut at co-ranks.
+void parallel_merge(const std::vector<CountingInt>& a, const std::vector<CountingInt>& b,
+                    std::vector<CountingInt>& result) {
+    const std::size_t total = result.size();
+    const std::size_t pieces = std::max<std::size_t>(1, (total + 16 * chunk_size - 1) / (16 * chunk_size));
+
+    std::vector<MergeSplit> splits(pieces + 1);
+    for (std::size_t p = 0; p <= pieces; ++p) {
+        splits[p] = co_rank(a.begin(), a.end(), b.begin(), b.end(), total * p / pieces);
+    }
+
+    // Compares the plain values: the comparison counter is not meant for the generator.
+    auto less = [](const CountingInt& x, const CountingInt& y) { return x.value < y.value; };
+    for_each_chunk(pieces, [&](std::size_t p) {
+        std::merge(a.begin() + splits[p].i, a.begin() + splits[p + 1].i,
+                   b.begin() + splits[p].j, b.begin() + splits[p + 1].j,
+                   result.begin() + (splits[p].i + splits[p].j), less);
+    });
+}
+
+} // namespace
+
+void seed_sorted_vectors(std::uint64_t seed) {
+    generator_seed = seed;
+    seeded = true;
+}
+
+std::uint64_t sorted_vectors_seed() {
+    ensure_seeded();
+    return generator_seed;
+}
+
+void set_sorted_vectors_threads(unsigned int threads) {
+    generator_threads = threads;
 }
 
 MergeTestCase generate_sorted_vectors(
@@ -21,10 +235,42 @@ MergeTestCase generate_sorted_vectors(
     int random_min,
     int random_max,
     int block_size_a,
-    int block_size_b)
+    int block_size_b,
+    int distinct_keys,
+    const DistributionParams& distribution)
+{
+    return generate_numbered_sorted_vectors(0, size_a, size_b, case_type, random_min, random_max,
+                                            block_size_a, block_size_b, distinct_keys, distribution);
+}
+
+MergeTestCase generate_numbered_sorted_vectors(
+    std::uint64_t test_case_number,
+    int size_a,
+    int size_b,
+    CornerCaseType case_type,
+    int random_min,
+    int random_max,
+    int block_size_a,
+    int block_size_b,
+    int distinct_keys,
+    const DistributionParams& distribution)
 {
-    // Seed for random number generation
-    srand(static_cast<unsigned int>(time(nullptr)));
+    if (test_case_number >= (std::uint64_t{1} << 62)) {
+        throw std::invalid_argument("Test case number must be below 2^62.");
+    }
+    // Every test case number gets its own pair of streams, so that the runs of a scenario
+    // get fresh data and a seed reproduces them regardless of how many runs there were.
+    ensure_seeded();
+    const CounterRng rng_a(generator_seed, 2 * test_case_number);
+    const CounterRng rng_b(generator_seed, 2 * test_case_number + 1);
+    const CounterRng rng_shared(generator_seed, (std::uint64_t{1} << 63) | test_case_number);  // Layout shared by A and B.
+
+    if (case_type == CornerCaseType::EXTREME_RATIO) {
+        if (distribution.ratio < 1) {
+            throw std::invalid_argument("EXTREME_RATIO corner case requires a ratio of at least 1.");
+        }
+        size_a = std::max(1, size_b / distribution.ratio);
+    }
 
     MergeTestCase test_case;
     // Pre-size the vectors where applicable.
@@ -34,36 +280,24 @@ MergeTestCase generate_sorted_vectors(
     switch (case_type) {
     case CornerCaseType::RANDOM:
         {
-            for (int i = 0; i < size_a; ++i) {
-                test_case.a[i] = CountingInt(rand_in_range(random_min, random_max), Slice::A);
-            }
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(random_min, random_max), Slice::B);
-            }
+            fill_sorted_uniform(test_case.a.data(), size_a, random_min, random_max, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, random_min, random_max, Slice::B, rng_b);
         }
         break;
 
     case CornerCaseType::FIRST_ALL_SMALLER:
         {
             int mid = (random_min + random_max) / 2;
-            for (int i = 0; i < size_a; ++i) {
-                test_case.a[i] = CountingInt(rand_in_range(random_min, mid), Slice::A);
-            }
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(mid + 1, random_max), Slice::B);
-            }
+            fill_sorted_uniform(test_case.a.data(), size_a, random_min, mid, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, mid + 1, random_max, Slice::B, rng_b);
         }
         break;
 
     case CornerCaseType::FIRST_ALL_GREATER:
         {
             int mid = (random_min + random_max) / 2;
-            for (int i = 0; i < size_a; ++i) {
-                test_case.a[i] = CountingInt(rand_in_range(mid + 1, random_max), Slice::A);
-            }
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(random_min, mid), Slice::B);
-            }
+            fill_sorted_uniform(test_case.a.data(), size_a, mid + 1, random_max, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, random_min, mid, Slice::B, rng_b);
         }
         break;
 
@@ -72,12 +306,8 @@ MergeTestCase generate_sorted_vectors(
             // Example: Let A be in [randomMin, mid2] and B be in [mid1, randomMax]
             int mid1 = random_min + (random_max - random_min) / 3;
             int mid2 = random_min + 2 * (random_max - random_min) / 3;
-            for (int i = 0; i < size_a; ++i) {
-                test_case.a[i] = CountingInt(rand_in_range(random_min, mid2), Slice::A);
-            }
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(mid1, random_max), Slice::B);
-            }
+            fill_sorted_uniform(test_case.a.data(), size_a, random_min, mid2, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, mid1, random_max, Slice::B, rng_b);
         }
         break;
 
@@ -85,10 +315,8 @@ MergeTestCase generate_sorted_vectors(
         {
             test_case.a.resize(1);
             test_case.b.resize(1);
-            test_case.a[0] = CountingInt(rand_in_range(random_min, random_max), Slice::A);
-            test_case.b[0] = CountingInt(rand_in_range(random_min, random_max), Slice::B);
-            size_a = 1;
-            size_b = 1;
+            fill_sorted_uniform(test_case.a.data(), 1, random_min, random_max, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), 1, random_min, random_max, Slice::B, rng_b);
         }
         break;
 
@@ -98,10 +326,10 @@ MergeTestCase generate_sorted_vectors(
                 throw std::runtime_error("EQUAL_ARRAYS corner case requires the same sizes for A and B.");
             }
 
-            for (int i = 0; i < size_a; ++i) {
-                int val = rand_in_range(random_min, random_max);
-                test_case.a[i] = CountingInt(val, Slice::A);
-                test_case.b[i] = CountingInt(val, Slice::B);
+            fill_sorted_uniform(test_case.a.data(), size_a, random_min, random_max, Slice::A, rng_a);
+            test_case.b = test_case.a;
+            for (auto& x : test_case.b) {
+                x.source = Slice::B;
             }
         }
         break;
@@ -109,12 +337,8 @@ MergeTestCase generate_sorted_vectors(
     case CornerCaseType::DUPLICATES_IN_BOTH:
         {
             // Use a small range to force duplicates.
-            for (int i = 0; i < size_a; ++i) {
-                test_case.a[i] = CountingInt(rand_in_range(0, 5), Slice::A);
-            }
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(0, 5), Slice::B);
-            }
+            fill_sorted_uniform(test_case.a.data(), size_a, 0, 5, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, 0, 5, Slice::B, rng_b);
         }
         break;
 
@@ -122,101 +346,196 @@ MergeTestCase generate_sorted_vectors(
         {
             test_case.a.clear();
             test_case.a.shrink_to_fit();
-            size_a = 0;
 
             // Fill b with random numbers.
-            for (int i = 0; i < size_b; ++i) {
-                test_case.b[i] = CountingInt(rand_in_range(random_min, random_max), Slice::B);
-            }
+            fill_sorted_uniform(test_case.b.data(), size_b, random_min, random_max, Slice::B, rng_b);
         }
         break;
 
     case CornerCaseType::BLOCK_INTERLEAVE_A_B:
+    case CornerCaseType::BLOCK_INTERLEAVE_B_A:
         {
+            // A_B: result = {K from a}, {L from b}, ...; B_A starts with the block of b.
+            const bool a_first = case_type == CornerCaseType::BLOCK_INTERLEAVE_A_B;
             int K = block_size_a;
             int L = block_size_b;
 
-            test_case.a.clear();
-            test_case.b.clear();
-            test_case.result.clear();
-
             // Determine how many blocks are needed for each vector.
             int num_blocks_a = (size_a + K - 1) / K;
             int num_blocks_b = (size_b + L - 1) / L;
             int total_blocks = std::max(num_blocks_a, num_blocks_b);
 
             // Calculate the range available per block step (each cycle uses two blocks).
-            int range_per_block = (random_max - random_min) / (total_blocks * 2);
+            int range_per_block = total_blocks == 0 ? 0 : (random_max - random_min) / (total_blocks * 2);
             int current_value = random_min;
 
-            // Fill arrays A and B in blocks.
-            for (int block = 0; block < total_blocks; ++block) {
-                // Fill block for A: up to K elements.
-                for (int i = 0; i < K && static_cast<int>(test_case.a.size()) < size_a; ++i) {
-                    test_case.a.push_back(CountingInt(rand_in_range(current_value, current_value + range_per_block - 1), Slice::A));
+            // Fill one block of up to `block` elements of v, values in the next value range.
+            // Block j draws from offset pos + j: one draw more than it has elements.
+            auto fill_block = [&](std::vector<CountingInt>& v, int& pos, int block, int j, Slice source,
+                                  const CounterRng& rng) {
+                int count = std::min(block, static_cast<int>(v.size()) - pos);
+                if (count > 0) {
+                    fill_sorted_uniform(v.data() + pos, count, current_value, current_value + range_per_block - 1,
+                                        source, rng, static_cast<std::uint64_t>(pos) + j);
+                    for (int i = 0; i < count; ++i) {
+                        v[pos + i].index = pos + i;
+                    }
+                    pos += count;
                 }
                 current_value += range_per_block;
+            };
 
-                // Fill block for B: up to L elements.
-                for (int i = 0; i < L && static_cast<int>(test_case.b.size()) < size_b; ++i) {
-                    test_case.b.push_back(CountingInt(rand_in_range(current_value, current_value + range_per_block - 1), Slice::B));
+            int pos_a = 0;
+            int pos_b = 0;
+            for (int block = 0; block < total_blocks; ++block) {
+                if (a_first) {
+                    fill_block(test_case.a, pos_a, K, block, Slice::A, rng_a);
+                    fill_block(test_case.b, pos_b, L, block, Slice::B, rng_b);
+                } else {
+                    fill_block(test_case.b, pos_b, L, block, Slice::B, rng_b);
+                    fill_block(test_case.a, pos_a, K, block, Slice::A, rng_a);
                 }
-                current_value += range_per_block;
             }
         }
         break;
 
-    case CornerCaseType::BLOCK_INTERLEAVE_B_A:
+    case CornerCaseType::LOW_CARDINALITY:
         {
-            int K = block_size_a;
-            int L = block_size_b;
+            if (distinct_keys < 1) {
+                throw std::invalid_argument("LOW_CARDINALITY corner case requires at least one distinct key.");
+            }
 
-            test_case.a.clear();
-            test_case.b.clear();
-            test_case.result.clear();
+            // Key k of D is randomMin + k * (randomMax - randomMin) / (D - 1), increasing in k,
+            // so sorted key numbers give sorted keys.
+            auto key = [&](double u) {
+                int k = std::min(distinct_keys - 1, static_cast<int>(u * distinct_keys));
+                return spaced_key(k, distinct_keys, random_min, random_max);
+            };
+            fill_sorted_unit(test_case.a.data(), size_a, Slice::A, rng_a, key);
+            fill_sorted_unit(test_case.b.data(), size_b, Slice::B, rng_b, key);
+        }
+        break;
 
-            // Determine how many blocks are needed for each vector.
-            int num_blocks_a = (size_a + K - 1) / K;
-            int num_blocks_b = (size_b + L - 1) / L;
-            int total_blocks = std::max(num_blocks_a, num_blocks_b);
+    case CornerCaseType::ZIPF:
+        {
+            if (distinct_keys < 1 || distribution.zipfExponent < 0) {
+                throw std::invalid_argument("ZIPF corner case requires at least one key and a non-negative exponent.");
+            }
 
-            // Calculate the range available per block step (each cycle uses two blocks).
-            int range_per_block = (random_max - random_min) / (total_blocks * 2);
-            int current_value = random_min;
+            // Inverse CDF over the keys in value order: non-decreasing, so the keys come out sorted.
+            const std::vector<double> cdf = zipf_cdf(distinct_keys, distribution.zipfExponent);
+            auto key = [&](double u) {
+                auto k = static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin());
+                return spaced_key(std::min(k, distinct_keys - 1), distinct_keys, random_min, random_max);
+            };
+            fill_sorted_unit(test_case.a.data(), size_a, Slice::A, rng_a, key);
+            fill_sorted_unit(test_case.b.data(), size_b, Slice::B, rng_b, key);
+        }
+        break;
 
-            // Fill arrays A and B in blocks.
-             for (int block = 0; block < total_blocks; ++block) {
-                // For this case, fill block for B first.
-                for (int i = 0; i < L && static_cast<int>(test_case.b.size()) < size_b; ++i) {
-                    test_case.b.push_back(CountingInt(rand_in_range(current_value, current_value + range_per_block - 1), Slice::B));
-                }
-                current_value += range_per_block;
+    case CornerCaseType::CLUSTERED:
+        {
+            if (distribution.clusters < 1 || distribution.clusterWidth < 1) {
+                throw std::invalid_argument("CLUSTERED corner case requires at least one cluster of positive width.");
+            }
 
-                // Then fill block for A.
-                for (int i = 0; i < K && static_cast<int>(test_case.a.size()) < size_a; ++i) {
-                    test_case.a.push_back(CountingInt(rand_in_range(current_value, current_value + range_per_block - 1), Slice::A));
-                }
-                current_value += range_per_block;
+            // The range is cut into C slots; burst j covers `width` values at a random place in
+            // slot j, so bursts are disjoint and in order. Both inputs share the bursts.
+            const long long range = std::max(1LL, static_cast<long long>(random_max) - random_min + 1);
+            const long long clusters = std::min<long long>(distribution.clusters, range);
+            const long long slot = range / clusters;
+            const long long width = std::min<long long>(distribution.clusterWidth, slot);
+            std::vector<long long> starts(clusters);
+            for (long long j = 0; j < clusters; ++j) {
+                starts[j] = random_min + j * slot + static_cast<long long>(rng_shared.draw(j) % (slot - width + 1));
             }
+            auto timestamp = [&](double u) {
+                long long j = std::min(clusters - 1, static_cast<long long>(u * clusters));
+                double within = u * clusters - static_cast<double>(j);
+                return static_cast<int>(starts[j] + std::min(width - 1, static_cast<long long>(within * width)));
+            };
+            fill_sorted_unit(test_case.a.data(), size_a, Slice::A, rng_a, timestamp);
+            fill_sorted_unit(test_case.b.data(), size_b, Slice::B, rng_b, timestamp);
         }
         break;
-    }
 
-    std::sort(test_case.a.begin(), test_case.a.end());
-    std::sort(test_case.b.begin(), test_case.b.end());
+    case CornerCaseType::ARITHMETIC_GAPS:
+        {
+            if (distribution.step < 1 || distribution.maxGap < 1) {
+                throw std::invalid_argument("ARITHMETIC_GAPS corner case requires a positive step and gap.");
+            }
 
-    // Update the indices to reflect the sorted order.
-    for (int i = 0; i < size_a; ++i) {
-        test_case.a[i].index = i;
-    }
-    for (int i = 0; i < size_b; ++i) {
-        test_case.b[i].index = i;
+            // Value 0 is randomMin plus an offset below the step; then every value is `step`
+            // above the previous one, plus 1..maxGap missing terms with probability p.
+            const double step = distribution.step;
+            auto fill = [&](std::vector<CountingInt>& v, Slice source, const CounterRng& rng) {
+                fill_prefix_sums(v.data(), v.size(), v.size(), source,
+                    [&](std::size_t k) {
+                        if (k == 0) return static_cast<double>(rng.draw(0) % distribution.step);
+                        double missing = 0.0;
+                        if (unit(rng.draw(2 * k)) < distribution.gapProbability) {
+                            missing = 1.0 + static_cast<double>(((rng.draw(2 * k + 1) >> 32) * distribution.maxGap) >> 32);
+                        }
+                        return step * (1.0 + missing);
+                    },
+                    [&](double prefix, double) { return saturate(random_min + prefix); });
+            };
+            fill(test_case.a, Slice::A, rng_a);
+            fill(test_case.b, Slice::B, rng_b);
+        }
+        break;
+
+    case CornerCaseType::LOG_NORMAL_GAPS:
+        {
+            if (distribution.gapSigma < 0) {
+                throw std::invalid_argument("LOG_NORMAL_GAPS corner case requires a non-negative sigma.");
+            }
+
+            auto fill = [&](std::vector<CountingInt>& v, Slice source, const CounterRng& rng) {
+                fill_prefix_sums(v.data(), v.size(), v.size(), source,
+                    [&](std::size_t k) { return std::exp(distribution.gapMu + distribution.gapSigma * standard_normal(rng, k)); },
+                    [&](double prefix, double) { return saturate(std::floor(random_min + prefix)); });
+            };
+            fill(test_case.a, Slice::A, rng_a);
+            fill(test_case.b, Slice::B, rng_b);
+        }
+        break;
+
+    case CornerCaseType::POSTING_LIST:
+        {
+            // Doc ids of a list of n documents out of the universe [randomMin, randomMax]: every
+            // id is in the list with probability p = n / |universe|, so the gaps are 1 plus a
+            // geometric number of skipped ids. Strictly increasing, like a real posting list.
+            const double universe = std::max(1.0, static_cast<double>(random_max) - random_min + 1.0);
+            auto fill = [&](std::vector<CountingInt>& v, Slice source, const CounterRng& rng) {
+                const double p = std::min(1.0, static_cast<double>(v.size()) / universe);
+                const double log_skip = std::log1p(-p);  // -inf for p == 1: no skips.
+                fill_prefix_sums(v.data(), v.size(), v.size(), source,
+                    [&](std::size_t k) {
+                        if (p >= 1.0) return 1.0;
+                        double u = 1.0 - unit(rng.draw(k));  // (0, 1]
+                        return 1.0 + std::floor(std::log(u) / log_skip);
+                    },
+                    [&](double prefix, double) { return saturate(random_min - 1.0 + prefix); });
+            };
+            fill(test_case.a, Slice::A, rng_a);
+            fill(test_case.b, Slice::B, rng_b);
+        }
+        break;
+
+    case CornerCaseType::EXTREME_RATIO:
+        {
+            // Sizes were adjusted above; the values are uniform as for RANDOM.
+            fill_sorted_uniform(test_case.a.data(), size_a, random_min, random_max, Slice::A, rng_a);
+            fill_sorted_uniform(test_case.b.data(), size_b, random_min, random_max, Slice::B, rng_b);
+        }
+        break;
     }
 
-    test_case.result.resize(size_a + size_b);
-    std::merge(test_case.a.begin(), test_case.a.end(),
-               test_case.b.begin(), test_case.b.end(),
-               test_case.result.begin());
+    // The inputs are generated sorted, with their indices; the expected result is their
+    // stable merge.
+    test_case.result.resize(test_case.a.size() + test_case.b.size());
+    parallel_merge(test_case.a, test_case.b, test_case.result);
 
     return test_case;
 }
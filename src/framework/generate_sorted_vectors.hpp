@@ -9,6 +9,7 @@
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <cstdint>
 #include "counting_int.hpp"
 
 enum class CornerCaseType {
@@ -21,7 +22,27 @@ enum class CornerCaseType {
     DUPLICATES_IN_BOTH,     // Each array has many duplicates
     ONE_ARRAY_EMPTY,        // One array is empty, the other non-empty
     BLOCK_INTERLEAVE_A_B,   // result = {{K from a}, {L from b}, {K from a}, {L from b}...};  1<= K,L; K+L<=m+n
-    BLOCK_INTERLEAVE_B_A    // result = {{K from b}, {L from a}, {K from b}, {L from a}...};  1<= K,L; K+L<=m+n
+    BLOCK_INTERLEAVE_B_A,   // result = {{K from b}, {L from a}, {K from b}, {L from a}...};  1<= K,L; K+L<=m+n
+    LOW_CARDINALITY,        // Both arrays draw from D distinct keys spread over [randomMin, randomMax]
+    ZIPF,                   // D distinct keys with Zipf(s) frequencies; popular keys scattered over the range
+    CLUSTERED,              // Bursty timestamps: C bursts of width W at random places, shared by A and B
+    ARITHMETIC_GAPS,        // Progressions with a common step from random offsets, with runs of missing terms
+    LOG_NORMAL_GAPS,        // Gaps between consecutive values are log-normal(mu, sigma)
+    POSTING_LIST,           // Strictly increasing doc ids, uniform density over [randomMin, randomMax]
+    EXTREME_RATIO           // Uniform values; A has max(1, N / ratio) elements (ratios up to 1:10^6)
+};
+
+// Parameters of the distribution families; each case reads only its own.
+struct DistributionParams {
+    double zipfExponent = 1.0;      // ZIPF: frequency of the k-th most popular key ~ 1 / k^s.
+    int clusters = 16;              // CLUSTERED: number of bursts.
+    int clusterWidth = 1000;        // CLUSTERED: value range of one burst.
+    int step = 4;                   // ARITHMETIC_GAPS: common difference.
+    double gapProbability = 0.1;    // ARITHMETIC_GAPS: probability that terms are missing before a value.
+    int maxGap = 64;                // ARITHMETIC_GAPS: at most this many consecutive terms missing.
+    double gapMu = 2.0;             // LOG_NORMAL_GAPS: mean of log(gap).
+    double gapSigma = 1.0;          // LOG_NORMAL_GAPS: standard deviation of log(gap).
+    int ratio = 1000000;            // EXTREME_RATIO: N / M.
 };
 
 
@@ -47,11 +68,46 @@ inline std::string toString(CornerCaseType caseType) {
             return "BLOCK_INTERLEAVE_A_B";
         case CornerCaseType::BLOCK_INTERLEAVE_B_A:
             return "BLOCK_INTERLEAVE_B_A";
+        case CornerCaseType::LOW_CARDINALITY:
+            return "LOW_CARDINALITY";
+        case CornerCaseType::ZIPF:
+            return "ZIPF";
+        case CornerCaseType::CLUSTERED:
+            return "CLUSTERED";
+        case CornerCaseType::ARITHMETIC_GAPS:
+            return "ARITHMETIC_GAPS";
+        case CornerCaseType::LOG_NORMAL_GAPS:
+            return "LOG_NORMAL_GAPS";
+        case CornerCaseType::POSTING_LIST:
+            return "POSTING_LIST";
+        case CornerCaseType::EXTREME_RATIO:
+            return "EXTREME_RATIO";
         default:
             return "UNKNOWN";
     }
 }
 
+// All corner cases, in declaration order.
+inline std::vector<CornerCaseType> allCornerCaseTypes() {
+    return {CornerCaseType::RANDOM, CornerCaseType::FIRST_ALL_SMALLER, CornerCaseType::FIRST_ALL_GREATER,
+            CornerCaseType::PARTIAL_OVERLAP, CornerCaseType::ONE_ELEMENT_EACH, CornerCaseType::EQUAL_ARRAYS,
+            CornerCaseType::DUPLICATES_IN_BOTH, CornerCaseType::ONE_ARRAY_EMPTY,
+            CornerCaseType::BLOCK_INTERLEAVE_A_B, CornerCaseType::BLOCK_INTERLEAVE_B_A,
+            CornerCaseType::LOW_CARDINALITY, CornerCaseType::ZIPF, CornerCaseType::CLUSTERED,
+            CornerCaseType::ARITHMETIC_GAPS, CornerCaseType::LOG_NORMAL_GAPS, CornerCaseType::POSTING_LIST,
+            CornerCaseType::EXTREME_RATIO};
+}
+
+// Inverse of toString; throws std::invalid_argument for an unknown name.
+inline CornerCaseType parseCornerCaseType(const std::string& name) {
+    for (CornerCaseType caseType : allCornerCaseTypes()) {
+        if (toString(caseType) == name) {
+            return caseType;
+        }
+    }
+    throw std::invalid_argument("unknown corner case " + name);
+}
+
 // Structure to hold the generated test case data.
 struct MergeTestCase {
     std::vector<CountingInt> a;
@@ -64,6 +120,14 @@ struct MergeTestCase {
  *
  * For the BLOCK_INTERLEAVE cases, additional parameters control the block sizes.
  * For all cases, randomMin and randomMax determine the random value range.
+ * For LOW_CARDINALITY and ZIPF, distinct_keys keys evenly spaced over that range are used.
+ * The gap-based families (ARITHMETIC_GAPS, LOG_NORMAL_GAPS, POSTING_LIST) start at
+ * randomMin and extend as far as their gaps take them.
+ * The values are drawn sorted (uniform spacings) from a seeded counter-based generator,
+ * in parallel for large inputs; the result is their stable merge (A before B). This is
+ * test case number 0 of generate_numbered_sorted_vectors: the data depends only on the
+ * seed and the arguments, so callers that need several different test cases of the same
+ * shape number them.
  *
  * @param size_a       Desired size of vector A.
  * @param size_b       Desired size of vector B.
@@ -72,6 +136,8 @@ struct MergeTestCase {
  * @param random_max   (Optional) Maximum random value, default 10000.
  * @param block_size_a (Optional) Block size for A in block interleaving cases, default 2.
  * @param block_size_b (Optional) Block size for B in block interleaving cases, default 3.
+ * @param distinct_keys (Optional) Number of distinct keys for LOW_CARDINALITY and ZIPF, default 16.
+ * @param distribution (Optional) Parameters of the distribution families.
  */
 MergeTestCase generate_sorted_vectors(int size_a,
                                       int size_b,
@@ -79,6 +145,50 @@ MergeTestCase generate_sorted_vectors(int size_a,
                                       int random_min = 0,
                                       int random_max = 10000,
                                       int block_size_a = 2,
-                                      int block_size_b = 3);
+                                      int block_size_b = 3,
+                                      int distinct_keys = 16,
+                                      const DistributionParams& distribution = {});
+
+/**
+ * Generates test case number `test_case_number` of the current seed. The data depends only
+ * on the seed, the number and the arguments (not on the number of threads or on what was
+ * generated before), so it can be regenerated, or cached, independently of the other test
+ * cases of a run.
+ *
+ * @param test_case_number Number of the test case, below 2^62.
+ * Other parameters as for generate_sorted_vectors.
+ */
+MergeTestCase generate_numbered_sorted_vectors(std::uint64_t test_case_number,
+                                               int size_a,
+                                               int size_b,
+                                               CornerCaseType case_type,
+                                               int random_min,
+                                               int random_max,
+                                               int block_size_a,
+                                               int block_size_b,
+                                               int distinct_keys,
+                                               const DistributionParams& distribution);
+
+/**
+ * Seeds the generator of generate_sorted_vectors, so that a run can be reproduced: every
+ * test case depends only on the seed, its number and the arguments. Without a call the
+ * generator is seeded from the clock and std::random_device on first use.
+ *
+ * @param seed Seed value.
+ */
+void seed_sorted_vectors(std::uint64_t seed);
+
+/**
+ * Seed of the test data generator (seeding it first if nothing did), for reports.
+ */
+std::uint64_t sorted_vectors_seed();
+
+/**
+ * Number of threads generate_sorted_vectors uses for large test cases (more than 2^16
+ * elements per input); 0, the default, uses std::thread::hardware_concurrency().
+ *
+ * @param threads Thread count.
+ */
+void set_sorted_vectors_threads(unsigned int threads);
 
 #endif // FRAMEWORK_H
@@ -10,15 +10,16 @@
 #include "merge_algorithm.hpp"
 #include "../algorithms/algorithms.hpp"
 
-class HwangLinDynamicMergeAlgorithm : public MergeAlgorithm {
+template <typename T = CountingInt>
+class HwangLinDynamicMergeAlgorithm : public MergeAlgorithm<T> {
 public:
     std::string getName() const override {
         return "HwangLinDynamicMerge";
     }
-    std::vector<CountingInt> merge(const std::vector<CountingInt>& a,
-                           const std::vector<CountingInt>& b) override {
-        std::vector<CountingInt> A = a;
-        std::vector<CountingInt> B = b;
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
+        std::vector<T> A = this->workingCopy(a);
+        std::vector<T> B = this->workingCopy(b);
 
         return hwang_lin_dynamic_merge(A, B);
     }
@@ -10,13 +10,14 @@
 #include "merge_algorithm.hpp"
 #include "../algorithms/algorithms.hpp"
 
-class HwangLinKnuthMergeAlgorithm : public MergeAlgorithm {
+template <typename T = CountingInt>
+class HwangLinKnuthMergeAlgorithm : public MergeAlgorithm<T> {
 public:
     std::string getName() const override {
         return "HwangLinKnuthMerge";
     }
-    std::vector<CountingInt> merge(const std::vector<CountingInt>& a,
-                           const std::vector<CountingInt>& b) override {
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
         return hwang_lin_knuth_merge(a, b);
     }
 };
@@ -10,19 +10,24 @@
 #include "merge_algorithm.hpp"
 #include "../algorithms/algorithms.hpp"
 
-class HwangLinStaticMergeAlgorithm : public MergeAlgorithm {
+template <typename T = CountingInt>
+class HwangLinStaticMergeAlgorithm : public MergeAlgorithm<T> {
 public:
     std::string getName() const override {
         return "HwangLinStaticMerge";
     }
-    std::vector<CountingInt> merge(const std::vector<CountingInt>& a,
-                           const std::vector<CountingInt>& b) override {
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
 
-        std::vector<CountingInt> A = a;
-        std::vector<CountingInt> B = b;
+        std::vector<T> A = this->workingCopy(a);
+        std::vector<T> B = this->workingCopy(b);
 
         return hwang_lin_static_merge(A, B);
     }
+    MergePlan mergePlan(const std::vector<T>& a,
+                        const std::vector<T>& b) override {
+        return hwang_lin_static_merge_plan(a, b);
+    }
 };
 
 #endif // HWANG_LIN_STATIC_MERGE_HPP
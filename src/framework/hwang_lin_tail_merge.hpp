@@ -0,0 +1,57 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Declares the HwangLinTailMergeAlgorithm class: the in-place tail merges of
+ *              tail_merge.hpp, with A as the sorted vector and B as the batch.
+ */
+
+#ifndef HWANG_LIN_TAIL_MERGE_HPP
+#define HWANG_LIN_TAIL_MERGE_HPP
+
+#include <string>
+#include "merge_algorithm.hpp"
+#include "../algorithms/tail_merge.hpp"
+
+// Hwang-Lin merge that fills the gap at the tail of the vector.
+enum class TailMergeVariant { Static, StaticStable, Knuth, KnuthStable, Dynamic, DynamicStable };
+
+// The working copy of A gets the capacity of the result, as a sorted container that takes
+// batches would have, so the merge itself never reallocates. Stable variants keep A
+// before equal elements of B, like the stable merges.
+template <typename T = CountingInt>
+class HwangLinTailMergeAlgorithm : public MergeAlgorithm<T> {
+public:
+    explicit HwangLinTailMergeAlgorithm(TailMergeVariant variant) : variant_(variant) {}
+
+    std::string getName() const override {
+        switch (variant_) {
+            case TailMergeVariant::Static:        return "HwangLinStaticTailMerge";
+            case TailMergeVariant::StaticStable:  return "HwangLinStaticStableTailMerge";
+            case TailMergeVariant::Knuth:         return "HwangLinKnuthTailMerge";
+            case TailMergeVariant::KnuthStable:   return "HwangLinKnuthStableTailMerge";
+            case TailMergeVariant::Dynamic:       return "HwangLinDynamicTailMerge";
+            case TailMergeVariant::DynamicStable: return "HwangLinDynamicStableTailMerge";
+        }
+        return "HwangLinTailMerge";
+    }
+
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
+
+        std::vector<T> v = this->workingCopy(a, a.size() + b.size());
+
+        switch (variant_) {
+            case TailMergeVariant::Static:        hwang_lin_static_tail_merge(v, b); break;
+            case TailMergeVariant::StaticStable:  hwang_lin_static_stable_tail_merge(v, b); break;
+            case TailMergeVariant::Knuth:         hwang_lin_knuth_tail_merge(v, b); break;
+            case TailMergeVariant::KnuthStable:   hwang_lin_knuth_stable_tail_merge(v, b); break;
+            case TailMergeVariant::Dynamic:       hwang_lin_dynamic_tail_merge(v, b); break;
+            case TailMergeVariant::DynamicStable: hwang_lin_dynamic_stable_tail_merge(v, b); break;
+        }
+        return v;
+    }
+
+private:
+    TailMergeVariant variant_;
+};
+
+#endif // HWANG_LIN_TAIL_MERGE_HPP
@@ -6,15 +6,64 @@
 #ifndef MERGE_ALGORITHM_HPP
 #define MERGE_ALGORITHM_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "counting_int.hpp"
+#include "../algorithms/merge_plan.hpp"
 
+// Interface of a merge algorithm on vectors of T. The framework instantiates it for
+// plain keys (timing) and for CountingInt (comparison counting and stability).
+template <typename T = CountingInt>
 class MergeAlgorithm {
 public:
+    using value_type = T;
+
     virtual std::string getName() const = 0;
-    virtual std::vector<CountingInt> merge(const std::vector<CountingInt>& a, const std::vector<CountingInt>& b) = 0;
+    virtual std::vector<T> merge(const std::vector<T>& a, const std::vector<T>& b) = 0;
+
+    // Returns the merge plan (interleaving of A and B) instead of the merged values.
+    // The default runs merge() and reads the source tag of every output element, so it
+    // needs CountingInt elements; algorithms that can emit segments directly override it.
+    virtual MergePlan mergePlan(const std::vector<T>& a, const std::vector<T>& b) {
+        if constexpr (std::is_same_v<T, CountingInt>) {
+            auto result = merge(a, b);
+            return merge_plan_from_result(result, [](const CountingInt& x) {
+                return x.source == Slice::A ? PlanSource::A : PlanSource::B;
+            });
+        } else {
+            (void)a;
+            (void)b;
+            throw std::logic_error(getName() + ": mergePlan needs source-tagged (CountingInt) elements.");
+        }
+    }
+
     virtual ~MergeAlgorithm() = default;
+
+protected:
+    // Copy of an input for algorithms that merge in place, with room for at least
+    // `capacity` elements. The copy is setup, not merge work: for CountingInt it is left
+    // out of the element operation counts, so that the counts of copying and non-copying
+    // algorithms compare.
+    static std::vector<T> workingCopy(const std::vector<T>& input, std::size_t capacity = 0) {
+        auto copy = [&]() {
+            std::vector<T> result;
+            result.reserve(std::max(capacity, input.size()));
+            result.insert(result.end(), input.begin(), input.end());
+            return result;
+        };
+        if constexpr (std::is_same_v<T, CountingInt>) {
+            const ElementOperations before = CountingInt::operations;
+            std::vector<T> result = copy();
+            CountingInt::operations = before;
+            return result;
+        } else {
+            return copy();
+        }
+    }
 };
 
 #endif // MERGE_ALGORITHM_HPP
@@ -0,0 +1,144 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Benchmark of co-rank selection in the union of two sorted arrays: one
+ *              merge_select per rank, the batched merge_select, and a full merge.
+ */
+
+#ifndef MERGE_SELECT_BENCHMARK_HPP
+#define MERGE_SELECT_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/merge_select.hpp"
+
+struct MergeSelectResult {
+    std::string algorithm;
+    int         sizeA;
+    int         sizeB;
+    std::size_t queries;
+    double      time;                  // All queries (ms).
+    double      comparisonsPerQuery;
+    bool        isCorrect;             // Every split agrees with a full stable merge.
+};
+
+class MergeSelectBenchmark {
+public:
+    void addShape(int sizeA, int sizeB) {
+        shapes_.push_back({sizeA, sizeB});
+    }
+
+    void addQueryCount(std::size_t queries) {
+        queryCounts_.push_back(queries);
+    }
+
+    std::vector<MergeSelectResult> run() {
+        std::vector<MergeSelectResult> results;
+        for (const auto& shape : shapes_) {
+            MergeTestCase testCase = generate_sorted_vectors(shape.sizeA, shape.sizeB, CornerCaseType::RANDOM, 0, 1000000);
+            const Values& a = testCase.a;
+            const Values& b = testCase.b;
+
+            // prefixA[k]: number of elements of a among the first k of the stable merge.
+            Values merged(a.size() + b.size());
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), merged.begin());
+            std::vector<std::size_t> prefixA(merged.size() + 1, 0);
+            for (std::size_t r = 0; r < merged.size(); ++r) {
+                prefixA[r + 1] = prefixA[r] + (merged[r].source == Slice::A);
+            }
+
+            for (std::size_t queries : queryCounts_) {
+                std::mt19937 rng(static_cast<unsigned>(queries));
+                std::uniform_int_distribution<std::size_t> rank(0, merged.size());
+                std::vector<std::size_t> ks(queries);
+                for (auto& k : ks) k = rank(rng);
+
+                auto check = [&](const std::vector<MergeSplit>& splits) {
+                    for (std::size_t q = 0; q < ks.size(); ++q) {
+                        if (splits[q].i != prefixA[ks[q]] || splits[q].j != ks[q] - prefixA[ks[q]]) return false;
+                    }
+                    return true;
+                };
+
+                results.push_back(measure("merge_select (per rank)", shape, queries, check, [&] {
+                    std::vector<MergeSplit> splits;
+                    for (std::size_t k : ks) splits.push_back(merge_select(a, b, k));
+                    return splits;
+                }));
+                results.push_back(measure("merge_select (batch)", shape, queries, check, [&] {
+                    return merge_select(a, b, ks);
+                }));
+                results.push_back(measure("two_way_merge + count", shape, queries, check, [&] {
+                    Values full = two_way_merge(a, b);
+                    std::vector<std::size_t> countA(full.size() + 1, 0);
+                    for (std::size_t r = 0; r < full.size(); ++r) countA[r + 1] = countA[r] + (full[r].source == Slice::A);
+                    std::vector<MergeSplit> splits;
+                    for (std::size_t k : ks) splits.push_back({countA[k], k - countA[k]});
+                    return splits;
+                }));
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<MergeSelectResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Merge Select Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(10) << "Size A"
+            << std::setw(10) << "Size B"
+            << std::setw(10) << "Queries"
+            << std::setw(12) << "Time(ms)"
+            << std::setw(18) << "Comparisons/Query"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.algorithm
+                << std::setw(10) << res.sizeA
+                << std::setw(10) << res.sizeB
+                << std::setw(10) << res.queries
+                << std::setw(12) << res.time
+                << std::setw(18) << res.comparisonsPerQuery
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Values = std::vector<CountingInt>;
+
+    struct Shape {
+        int sizeA;
+        int sizeB;
+    };
+
+    template <typename Check, typename Select>
+    static MergeSelectResult measure(const std::string& name, const Shape& shape, std::size_t queries,
+                                     Check check, Select select) {
+        CountingInt::resetCounter();
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<MergeSplit> splits = select();
+        auto end = std::chrono::high_resolution_clock::now();
+        const double comparisons = static_cast<double>(CountingInt::comparisons) / std::max<std::size_t>(queries, 1);
+
+        return {name, shape.sizeA, shape.sizeB, queries,
+                std::chrono::duration<double, std::milli>(end - start).count(), comparisons, check(splits)};
+    }
+
+    std::vector<Shape>       shapes_;
+    std::vector<std::size_t> queryCounts_;
+};
+
+#endif // MERGE_SELECT_BENCHMARK_HPP
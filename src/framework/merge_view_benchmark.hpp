@@ -0,0 +1,187 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Benchmark of the lazy merged view: summing the merge by plain iteration of
+ *              views::merge and by for_each_block, against std::merge into a vector.
+ */
+
+#ifndef MERGE_VIEW_BENCHMARK_HPP
+#define MERGE_VIEW_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/merge_view.hpp"
+
+struct MergeViewShape {
+    int            sizeA;
+    int            sizeB;
+    CornerCaseType caseType;
+    int            blockSizeA = 2; // Block sizes of the generator (BLOCK_INTERLEAVE cases).
+    int            blockSizeB = 3;
+};
+
+struct MergeViewResult {
+    MergeViewShape shape;
+    std::size_t    runs;         // Calls of the for_each_block callback.
+    double         mergeTime;    // std::merge into a vector, then the sum (ms).
+    double         iterateTime;  // Sum over views::merge (ms).
+    double         blockTime;    // Sum over for_each_block runs (ms).
+    bool           isCorrect;    // Both view walks give the expected result (with origins) and sum.
+};
+
+/*
+ * Every time is the best of `repetitions` runs over int32 keys summed into an int64. The
+ * correctness check walks the view over the CountingInt test case, so the order of equal
+ * keys (A first) is checked as well.
+ */
+class MergeViewBenchmark {
+public:
+    explicit MergeViewBenchmark(int repetitions = 5) : repetitions_(std::max(repetitions, 1)) {}
+
+    void addShape(const MergeViewShape& shape) {
+        shapes_.push_back(shape);
+    }
+
+    std::vector<MergeViewResult> run() {
+        std::vector<MergeViewResult> results;
+        for (std::size_t i = 0; i < shapes_.size(); ++i) {
+            const MergeViewShape& shape = shapes_[i];
+            MergeViewResult result{shape, 0, 0.0, 0.0, 0.0, true};
+
+            std::vector<std::int32_t> a;
+            std::vector<std::int32_t> b;
+            std::int64_t expected = 0;
+            {
+                MergeTestCase test_case = generate_numbered_sorted_vectors(
+                    i, shape.sizeA, shape.sizeB, shape.caseType, 0, std::numeric_limits<std::int32_t>::max() / 2,
+                    shape.blockSizeA, shape.blockSizeB, 16, {});
+                result.isCorrect = check(test_case, result.runs);
+                a = keys(test_case.a);
+                b = keys(test_case.b);
+                for (const auto& x : test_case.result) expected += x.value;
+            }
+
+            std::vector<std::int32_t> out(a.size() + b.size());
+            result.mergeTime = best([&]() {
+                std::merge(a.begin(), a.end(), b.begin(), b.end(), out.begin());
+                std::int64_t sum = 0;
+                for (std::int32_t x : out) sum += x;
+                return sum;
+            }, expected, result.isCorrect);
+
+            result.iterateTime = best([&]() {
+                std::int64_t sum = 0;
+                for (std::int32_t x : views::merge(a, b)) sum += x;
+                return sum;
+            }, expected, result.isCorrect);
+
+            result.blockTime = best([&]() {
+                std::int64_t sum = 0;
+                views::merge(a, b).for_each_block([&](auto run) {
+                    for (std::int32_t x : run) sum += x;
+                });
+                return sum;
+            }, expected, result.isCorrect);
+
+            results.push_back(result);
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<MergeViewResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(118, '-');
+        oss << "Merge View Report (best of " << repetitions_ << "):\n" << separator << "\n";
+        oss << std::left
+            << std::setw(10) << "SizeA"
+            << std::setw(11) << "SizeB"
+            << std::setw(24) << "Case"
+            << std::setw(11) << "Runs"
+            << std::setw(15) << "Merge+sum(ms)"
+            << std::setw(13) << "Iterate(ms)"
+            << std::setw(12) << "Blocks(ms)"
+            << std::setw(16) << "Blocks/Iterate"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(10) << res.shape.sizeA
+                << std::setw(11) << res.shape.sizeB
+                << std::setw(24) << toString(res.shape.caseType)
+                << std::setw(11) << res.runs
+                << std::setw(15) << res.mergeTime
+                << std::setw(13) << res.iterateTime
+                << std::setw(12) << res.blockTime
+                << std::setw(16) << (res.iterateTime > 0 ? res.blockTime / res.iterateTime : 0.0)
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    // Best time of `sum` over the repetitions (ms); clears isCorrect on a wrong sum.
+    template <typename Sum>
+    double best(Sum sum, std::int64_t expected, bool& isCorrect) const {
+        double time = std::numeric_limits<double>::max();
+        for (int r = 0; r < repetitions_; ++r) {
+            auto start = std::chrono::high_resolution_clock::now();
+            std::int64_t total = sum();
+            auto end = std::chrono::high_resolution_clock::now();
+            time = std::min(time, std::chrono::duration<double, std::milli>(end - start).count());
+            isCorrect = isCorrect && total == expected;
+        }
+        return time;
+    }
+
+    // Walks both forms of the view over the test case and compares them with its result.
+    static bool check(const MergeTestCase& test_case, std::size_t& runs) {
+        auto same = [](const CountingInt& x, const CountingInt& y) {
+            return x.value == y.value && x.source == y.source && x.index == y.index;
+        };
+        auto view = views::merge(test_case.a, test_case.b);
+
+        std::size_t k = 0;
+        bool isCorrect = true;
+        for (const CountingInt& x : view) {
+            isCorrect = isCorrect && k < test_case.result.size() && same(x, test_case.result[k]);
+            ++k;
+        }
+        isCorrect = isCorrect && k == test_case.result.size();
+
+        // Runs are non-empty, come from one side and alternate between the sides.
+        k = 0;
+        runs = 0;
+        Slice last = Slice::B;
+        view.for_each_block([&](auto run) {
+            isCorrect = isCorrect && !run.empty() && (runs == 0 || run.front().source != last);
+            last = run.empty() ? last : run.front().source;
+            for (const CountingInt& x : run) {
+                isCorrect = isCorrect && x.source == last && k < test_case.result.size() && same(x, test_case.result[k]);
+                ++k;
+            }
+            ++runs;
+        });
+        return isCorrect && k == test_case.result.size();
+    }
+
+    static std::vector<std::int32_t> keys(const std::vector<CountingInt>& values) {
+        std::vector<std::int32_t> out;
+        out.reserve(values.size());
+        for (const auto& x : values) out.push_back(x.value);
+        return out;
+    }
+
+    int repetitions_;
+    std::vector<MergeViewShape> shapes_;
+};
+
+#endif // MERGE_VIEW_BENCHMARK_HPP
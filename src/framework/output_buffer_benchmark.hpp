@@ -0,0 +1,208 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Cost of the output of the out-of-place merges: a value-initialized std::vector
+ *              versus an uninitialized OutputBuffer (aligned, huge pages, pre-faulted), with the
+ *              first-touch (page fault) cost reported apart from the merge itself.
+ */
+
+#ifndef OUTPUT_BUFFER_BENCHMARK_HPP
+#define OUTPUT_BUFFER_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/output_buffer.hpp"
+
+struct OutputBufferResult {
+    std::string algorithm;
+    std::string output;     // Kind of output storage.
+    int         sizeA;
+    int         sizeB;
+    double      allocTime;  // Constructing the output (ms); includes the zero-fill of std::vector.
+    double      touchTime;  // First touch of the output pages (ms), see generateReport.
+    double      coldTime;   // Merge into the freshly constructed output (ms).
+    double      warmTime;   // Second merge into the same, already faulted output (ms).
+    double      totalTime;  // Construction + explicit prefault + cold merge (ms).
+    std::string pages;      // Pages actually obtained.
+    bool        isCorrect;  // Equal to std::merge of the inputs.
+};
+
+class OutputBufferBenchmark {
+public:
+    void addShape(int sizeA, int sizeB) {
+        shapes_.push_back({sizeA, sizeB});
+    }
+
+    std::vector<OutputBufferResult> run() {
+        const std::vector<std::pair<std::string, MergeFn>> algorithms = {
+            {"TwoWayMerge", [](const Values& a, const Values& b, Value* out) {
+                 two_way_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"HwangLinKnuthMerge", [](const Values& a, const Values& b, Value* out) {
+                 hwang_lin_knuth_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"HwangLinStaticMerge", [](const Values& a, const Values& b, Value* out) {
+                 hwang_lin_static_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"HwangLinStaticStableMerge", [](const Values& a, const Values& b, Value* out) {
+                 hwang_lin_static_stable_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"HwangLinDynamicMerge", [](const Values& a, const Values& b, Value* out) {
+                 hwang_lin_dynamic_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"HwangLinDynamicStableMerge", [](const Values& a, const Values& b, Value* out) {
+                 hwang_lin_dynamic_stable_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+            {"FractileInsertionMerge", [](const Values& a, const Values& b, Value* out) {
+                 fractile_insertion_merge_into(a.begin(), a.end(), b.begin(), b.end(), out);
+             }},
+        };
+
+        const std::vector<std::pair<std::string, OutputBufferOptions>> buffers = {
+            {"OutputBuffer",          {64, OutputPages::Default, false}},
+            {"OutputBuffer+prefault", {64, OutputPages::Default, true}},
+            {"THP+prefault",          {OutputBuffer<Value>::kHugePageSize, OutputPages::TransparentHuge, true}},
+            {"hugetlb+prefault",      {OutputBuffer<Value>::kHugePageSize, OutputPages::ExplicitHuge, true}},
+        };
+
+        std::vector<OutputBufferResult> results;
+        for (const auto& [sizeA, sizeB] : shapes_) {
+            Values a, b;
+            generate(sizeA, sizeB, a, b);
+            Values expected(a.size() + b.size());
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+
+            for (const auto& [name, merge] : algorithms) {
+                results.push_back(runVector(name, sizeA, sizeB, a, b, expected, merge));
+                for (const auto& [output, options] : buffers) {
+                    results.push_back(runBuffer(name, output, options, sizeA, sizeB, a, b, expected, merge));
+                }
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<OutputBufferResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Output Buffer Report (FirstTouch: zero-fill for std::vector, explicit prefault, "
+               "otherwise cold - warm merge):\n"
+            << separator << "\n";
+        oss << std::left
+            << std::setw(28) << "Algorithm"
+            << std::setw(23) << "Output"
+            << std::setw(10) << "SizeA"
+            << std::setw(10) << "SizeB"
+            << std::setw(10) << "Alloc"
+            << std::setw(12) << "FirstTouch"
+            << std::setw(10) << "Cold"
+            << std::setw(10) << "Warm"
+            << std::setw(10) << "Total"
+            << std::setw(10) << "Pages"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(28) << res.algorithm
+                << std::setw(23) << res.output
+                << std::setw(10) << res.sizeA
+                << std::setw(10) << res.sizeB
+                << std::setw(10) << res.allocTime
+                << std::setw(12) << res.touchTime
+                << std::setw(10) << res.coldTime
+                << std::setw(10) << res.warmTime
+                << std::setw(10) << res.totalTime
+                << std::setw(10) << res.pages
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        oss << "All times in ms.\n";
+        return oss.str();
+    }
+
+private:
+    using Value = std::int32_t;
+    using Values = std::vector<Value>;
+    using MergeFn = std::function<void(const Values&, const Values&, Value*)>;
+    using Clock = std::chrono::high_resolution_clock;
+
+    static double elapsed(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    static const char* pagesName(OutputPages pages) {
+        switch (pages) {
+            case OutputPages::TransparentHuge: return "THP";
+            case OutputPages::ExplicitHuge:    return "hugetlb";
+            default:                           return "4K";
+        }
+    }
+
+    // Baseline: what the container API does today.
+    static OutputBufferResult runVector(const std::string& name, int sizeA, int sizeB,
+                                        const Values& a, const Values& b, const Values& expected,
+                                        const MergeFn& merge) {
+        auto start = Clock::now();
+        Values out(a.size() + b.size());
+        auto allocated = Clock::now();
+        merge(a, b, out.data());
+        auto cold = Clock::now();
+        merge(a, b, out.data());
+        auto warm = Clock::now();
+
+        double allocTime = elapsed(start, allocated);
+        return {name, "std::vector", sizeA, sizeB, allocTime, allocTime,
+                elapsed(allocated, cold), elapsed(cold, warm), elapsed(start, cold),
+                "4K", out == expected};
+    }
+
+    static OutputBufferResult runBuffer(const std::string& name, const std::string& output,
+                                        OutputBufferOptions options, int sizeA, int sizeB,
+                                        const Values& a, const Values& b, const Values& expected,
+                                        const MergeFn& merge) {
+        const bool prefault = options.prefault;
+        options.prefault = false;
+
+        auto start = Clock::now();
+        OutputBuffer<Value> out(a.size() + b.size(), options);
+        auto allocated = Clock::now();
+        if (prefault) out.prefault();
+        auto touched = Clock::now();
+        merge(a, b, out.data());
+        auto cold = Clock::now();
+        merge(a, b, out.data());
+        auto warm = Clock::now();
+
+        double coldTime = elapsed(touched, cold);
+        double warmTime = elapsed(cold, warm);
+        double touchTime = prefault ? elapsed(allocated, touched) : std::max(0.0, coldTime - warmTime);
+        return {name, output, sizeA, sizeB, elapsed(start, allocated), touchTime, coldTime, warmTime,
+                elapsed(start, cold), pagesName(out.pages()),
+                std::equal(out.begin(), out.end(), expected.begin(), expected.end())};
+    }
+
+    static void generate(int sizeA, int sizeB, Values& a, Values& b) {
+        std::mt19937 rng(static_cast<unsigned>(sizeA) * 31u + static_cast<unsigned>(sizeB));
+        std::uniform_int_distribution<Value> value(0, 1000000000);
+        a.resize(static_cast<std::size_t>(sizeA));
+        b.resize(static_cast<std::size_t>(sizeB));
+        std::generate(a.begin(), a.end(), [&] { return value(rng); });
+        std::generate(b.begin(), b.end(), [&] { return value(rng); });
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+    }
+
+    std::vector<std::pair<int, int>> shapes_;
+};
+
+#endif // OUTPUT_BUFFER_BENCHMARK_HPP
@@ -0,0 +1,155 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Speedup curve of the parallel merges (in-place SymMerge and SplitMerge, fractile
+ *              insertion into a preallocated output) on the work-stealing scheduler for 1 to 64 threads.
+ */
+
+#ifndef PARALLEL_MERGE_BENCHMARK_HPP
+#define PARALLEL_MERGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/parallel_merge.hpp"
+
+struct ParallelMergeResult {
+    std::string algorithm;
+    int sizeA;
+    int sizeB;
+    std::size_t threads;  // 0 for the sequential algorithm.
+    double time;          // ms
+    double speedup;       // Sequential time / time.
+    bool isCorrect;       // Equal to std::merge of the inputs.
+};
+
+class ParallelMergeBenchmark {
+public:
+    explicit ParallelMergeBenchmark(std::vector<std::size_t> threadCounts = {1, 2, 4, 8, 16, 32, 64})
+        : threadCounts_(std::move(threadCounts)) {}
+
+    void addShape(int sizeA, int sizeB) {
+        shapes_.push_back({sizeA, sizeB});
+    }
+
+    std::vector<ParallelMergeResult> run() {
+        // Every function merges data[0, sizeA) with data[sizeA, end) and leaves the result in
+        // data; the out-of-place ones write to buffer (same size) and swap it in.
+        const std::vector<std::tuple<std::string, SequentialFn, ParallelFn>> algorithms = {
+            {"SimpleKimKutznerMerge",
+             [](Values& data, int sizeA, Values&) {
+                 simple_kim_kutzner_alg(data.begin(), data.begin() + sizeA, data.end());
+             },
+             [](WorkStealingScheduler& ws, Values& data, int sizeA, Values&) {
+                 parallel_simple_kim_kutzner_alg(ws, data.begin(), data.begin() + sizeA, data.end());
+             }},
+            {"SplitMerge",
+             [](Values& data, int sizeA, Values&) {
+                 split_merge_alg(data.begin(), data.begin() + sizeA, data.end());
+             },
+             [](WorkStealingScheduler& ws, Values& data, int sizeA, Values&) {
+                 parallel_split_merge_alg(ws, data.begin(), data.begin() + sizeA, data.end());
+             }},
+            {"FractileInsertionMerge",
+             [](Values& data, int sizeA, Values& buffer) {
+                 fractile_insertion_merge_into(data.begin(), data.begin() + sizeA, data.begin() + sizeA, data.end(),
+                                               buffer.begin());
+                 data.swap(buffer);
+             },
+             [](WorkStealingScheduler& ws, Values& data, int sizeA, Values& buffer) {
+                 parallel_fractile_insertion_merge_into(ws, data.begin(), data.begin() + sizeA,
+                                                        data.begin() + sizeA, data.end(), buffer.begin());
+                 data.swap(buffer);
+             }},
+        };
+
+        std::vector<ParallelMergeResult> results;
+        for (const auto& [sizeA, sizeB] : shapes_) {
+            Values input = generate(sizeA, sizeB);
+            Values expected(input.size());
+            std::merge(input.begin(), input.begin() + sizeA, input.begin() + sizeA, input.end(), expected.begin());
+
+            for (const auto& [name, sequential, parallel] : algorithms) {
+                Values data = input;
+                Values buffer(input.size());
+                auto start = std::chrono::high_resolution_clock::now();
+                sequential(data, sizeA, buffer);
+                auto end = std::chrono::high_resolution_clock::now();
+                double sequentialTime = std::chrono::duration<double, std::milli>(end - start).count();
+                results.push_back({name, sizeA, sizeB, 0, sequentialTime, 1.0, data == expected});
+
+                for (std::size_t threads : threadCounts_) {
+                    WorkStealingScheduler scheduler(threads);
+                    data = input;
+                    start = std::chrono::high_resolution_clock::now();
+                    parallel(scheduler, data, sizeA, buffer);
+                    end = std::chrono::high_resolution_clock::now();
+                    double time = std::chrono::duration<double, std::milli>(end - start).count();
+                    results.push_back({name, sizeA, sizeB, threads, time, sequentialTime / time, data == expected});
+                }
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<ParallelMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Parallel Merge Report (hardware threads: " << std::thread::hardware_concurrency() << "):\n"
+            << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(12) << "SizeA"
+            << std::setw(12) << "SizeB"
+            << std::setw(12) << "Threads"
+            << std::setw(14) << "Time(ms)"
+            << std::setw(12) << "Speedup"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.algorithm
+                << std::setw(12) << res.sizeA
+                << std::setw(12) << res.sizeB
+                << std::setw(12) << (res.threads == 0 ? std::string("sequential") : std::to_string(res.threads))
+                << std::setw(14) << res.time
+                << std::setw(12) << res.speedup
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Value = std::int32_t;
+    using Values = std::vector<Value>;
+    using SequentialFn = std::function<void(Values&, int, Values&)>;
+    using ParallelFn = std::function<void(WorkStealingScheduler&, Values&, int, Values&)>;
+
+    // A followed by B, both sorted.
+    static Values generate(int sizeA, int sizeB) {
+        std::mt19937 rng(static_cast<unsigned>(sizeA) * 31u + static_cast<unsigned>(sizeB));
+        std::uniform_int_distribution<Value> value(0, 1000000);
+        Values data(static_cast<std::size_t>(sizeA) + sizeB);
+        std::generate(data.begin(), data.end(), [&] { return value(rng); });
+        std::sort(data.begin(), data.begin() + sizeA);
+        std::sort(data.begin() + sizeA, data.end());
+        return data;
+    }
+
+    std::vector<std::size_t> threadCounts_;
+    std::vector<std::pair<int, int>> shapes_;
+};
+
+#endif // PARALLEL_MERGE_BENCHMARK_HPP
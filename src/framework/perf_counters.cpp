@@ -0,0 +1,161 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Implements PerfCounters on top of perf_event_open (no-op outside Linux).
+ */
+
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+namespace {
+
+struct EventSpec {
+    std::uint32_t type;
+    std::uint64_t config;
+    long long PerfCounterValues::* field;
+};
+
+constexpr std::uint64_t cacheReadMiss(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Cycles first: the leader of the group should be the event that is always there.
+const EventSpec events[] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, &PerfCounterValues::cycles},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, &PerfCounterValues::instructions},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, &PerfCounterValues::branchMisses},
+    {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_L1D), &PerfCounterValues::l1dMisses},
+    {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_LL), &PerfCounterValues::llcMisses},
+    {PERF_TYPE_HW_CACHE, cacheReadMiss(PERF_COUNT_HW_CACHE_DTLB), &PerfCounterValues::dtlbMisses},
+};
+
+int openEvent(const EventSpec& spec, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = groupFd == -1 ? 1 : 0;  // Members follow their leader.
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+} // namespace
+
+PerfCounters::PerfCounters() {
+    if (!open(true)) return;
+
+    // A group runs all-or-nothing: if it never got onto the PMU, count events separately.
+    start();
+    PerfCounterValues probe = stop();
+    if (!probe.isAvailable()) {
+        close();
+        open(false);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+bool PerfCounters::open(bool grouped) {
+    int lastErrno = 0;
+    for (const auto& spec : events) {
+        if (!grouped || groups_.empty()) {
+            int fd = openEvent(spec, -1);
+            if (fd == -1) {
+                lastErrno = errno;
+                continue;
+            }
+            groups_.push_back({{fd}, {spec.field}});
+        } else {
+            int fd = openEvent(spec, groups_.front().fds.front());
+            if (fd == -1) {
+                lastErrno = errno;
+                continue;
+            }
+            groups_.front().fds.push_back(fd);
+            groups_.front().fields.push_back(spec.field);
+        }
+    }
+
+    if (groups_.empty()) {
+        unavailableReason_ = std::string("perf_event_open: ") + std::strerror(lastErrno);
+        return false;
+    }
+    unavailableReason_.clear();
+    return true;
+}
+
+void PerfCounters::close() {
+    for (const auto& group : groups_) {
+        for (int fd : group.fds) ::close(fd);
+    }
+    groups_.clear();
+}
+
+void PerfCounters::start() {
+    for (const auto& group : groups_) {
+        ioctl(group.fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group.fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+PerfCounterValues PerfCounters::stop() {
+    for (const auto& group : groups_) {
+        ioctl(group.fds.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    PerfCounterValues values;
+    for (const auto& group : groups_) {
+        // Layout of a group read: nr, time_enabled, time_running, value[nr].
+        std::vector<std::uint64_t> buffer(3 + group.fds.size());
+        ssize_t bytes = read(group.fds.front(), buffer.data(), buffer.size() * sizeof(std::uint64_t));
+        if (bytes < static_cast<ssize_t>(3 * sizeof(std::uint64_t))) continue;
+
+        const std::uint64_t count = std::min<std::uint64_t>(buffer[0], group.fields.size());
+        const std::uint64_t enabled = buffer[1];
+        const std::uint64_t running = buffer[2];
+        if (running == 0) continue;  // Never scheduled: leave the values unavailable.
+
+        const double scale = static_cast<double>(enabled) / static_cast<double>(running);
+        for (std::uint64_t k = 0; k < count; ++k) {
+            values.*group.fields[k] = static_cast<long long>(static_cast<double>(buffer[3 + k]) * scale);
+        }
+    }
+    return values;
+}
+
+#else
+
+PerfCounters::PerfCounters() : unavailableReason_("hardware counters need Linux perf_event_open") {}
+
+PerfCounters::~PerfCounters() {}
+
+bool PerfCounters::open(bool) {
+    return false;
+}
+
+void PerfCounters::close() {}
+
+void PerfCounters::start() {}
+
+PerfCounterValues PerfCounters::stop() {
+    return {};
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Hardware performance counters (cycles, instructions, branch, cache and TLB
+ *              misses) around a measured call, via Linux perf_event_open.
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <string>
+#include <vector>
+
+// Counter values of one measured call; -1 marks a counter that is not available.
+struct PerfCounterValues {
+    long long cycles = -1;
+    long long instructions = -1;
+    long long branchMisses = -1;
+    long long l1dMisses = -1;      // L1 data cache read misses.
+    long long llcMisses = -1;      // Last-level cache read misses.
+    long long dtlbMisses = -1;     // Data TLB read misses.
+
+    // Instructions per cycle, or -1 if either counter is not available.
+    double ipc() const {
+        if (cycles <= 0 || instructions < 0) return -1.0;
+        return static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    bool isAvailable() const {
+        return cycles >= 0 || instructions >= 0 || branchMisses >= 0 ||
+               l1dMisses >= 0 || llcMisses >= 0 || dtlbMisses >= 0;
+    }
+};
+
+/*
+ * User-space counters of the calling thread. All events are opened as one group so they
+ * count over exactly the same instructions. If the CPU cannot schedule the whole group at
+ * once, every event gets its own group instead and the values are scaled for multiplexing.
+ * Events the kernel refuses (no PMU, e.g. in a VM; perf_event_paranoid; not Linux) stay
+ * at -1, and if none can be opened start() and stop() do nothing.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool isAvailable() const {
+        return !groups_.empty();
+    }
+
+    // Why no counter could be opened (empty if some could).
+    const std::string& getUnavailableReason() const {
+        return unavailableReason_;
+    }
+
+    void start();
+    PerfCounterValues stop();
+
+private:
+    using Field = long long PerfCounterValues::*;
+
+    struct Group {
+        std::vector<int>   fds;     // fds[0] is the group leader.
+        std::vector<Field> fields;  // Where each member's value goes.
+    };
+
+    bool open(bool grouped);
+    void close();
+
+    std::vector<Group> groups_;
+    std::string        unavailableReason_;
+};
+
+#endif // PERF_COUNTERS_HPP
@@ -0,0 +1,201 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Checks and times the sorted run files: dumps generated test cases, reads them
+ *              back, merges them through the skip index and streams them, all against the
+ *              expected result.
+ */
+
+#ifndef RUN_FILE_BENCHMARK_HPP
+#define RUN_FILE_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "test_case_dump.hpp"
+#include "../algorithms/sorted_run_file.hpp"
+#include "../algorithms/streaming_merge.hpp"
+
+struct RunFileShape {
+    int            sizeA;
+    int            sizeB;
+    CornerCaseType caseType;
+    std::uint32_t  fileBlockSize; // Elements per block of the run files.
+    int            blockSizeA = 2; // Block sizes of the generator (BLOCK_INTERLEAVE cases).
+    int            blockSizeB = 3;
+};
+
+struct RunFileResult {
+    RunFileShape      shape;
+    RunEncoding       encodingA;     // Encoding of the A file; also of the merged file.
+    RunEncoding       encodingB;
+    double            mergeTime;     // merge_sorted_run_files (ms).
+    double            streamTime;    // StreamingMerge over SortedRunChunkSource (ms).
+    RunFileMergeStats stats;
+    bool              isCorrect;     // Read back, merged and streamed keys all equal the expected ones.
+};
+
+/*
+ * Every shape is dumped once per encoding with dump_merge_test_case. Merging files of the
+ * same encoding copies the blocks that precede the other side byte for byte; files of
+ * different encodings take the re-encoding path instead.
+ */
+class RunFileBenchmark {
+public:
+    explicit RunFileBenchmark(std::string directory) : directory_(std::move(directory)) {}
+
+    void addShape(const RunFileShape& shape) {
+        shapes_.push_back(shape);
+    }
+
+    std::vector<RunFileResult> run() {
+        const RunEncoding encodings[] = {RunEncoding::Fixed, RunEncoding::DeltaVarint};
+        std::vector<RunFileResult> results;
+        for (std::size_t i = 0; i < shapes_.size(); ++i) {
+            const RunFileShape& shape = shapes_[i];
+            MergeTestCase test_case = generate_numbered_sorted_vectors(
+                i, shape.sizeA, shape.sizeB, shape.caseType, 0, 1000000, shape.blockSizeA, shape.blockSizeB, 16, {});
+            std::vector<std::int32_t> a = keys(test_case.a);
+            std::vector<std::int32_t> b = keys(test_case.b);
+            std::vector<std::int32_t> expected = keys(test_case.result);
+
+            // Both dumps must read back unchanged.
+            bool readBack = true;
+            for (RunEncoding encoding : encodings) {
+                dump_merge_test_case(test_case, prefix(encoding), encoding, shape.fileBlockSize);
+                readBack = readBack &&
+                           SortedRunReader<std::int32_t>(prefix(encoding) + "_a.run").read_all() == a &&
+                           SortedRunReader<std::int32_t>(prefix(encoding) + "_b.run").read_all() == b &&
+                           SortedRunReader<std::int32_t>(prefix(encoding) + "_result.run").read_all() == expected;
+            }
+
+            for (RunEncoding encodingA : encodings) {
+                for (RunEncoding encodingB : encodings) {
+                    RunFileResult result{shape, encodingA, encodingB, 0.0, 0.0, {}, readBack};
+                    const std::string merged = path("merged.run");
+
+                    auto start = std::chrono::high_resolution_clock::now();
+                    {
+                        SortedRunReader<std::int32_t> readerA(prefix(encodingA) + "_a.run");
+                        SortedRunReader<std::int32_t> readerB(prefix(encodingB) + "_b.run");
+                        SortedRunWriter<std::int32_t> writer(merged, encodingA, shape.fileBlockSize, RunStability::Stable);
+                        result.stats = merge_sorted_run_files(readerA, readerB, writer);
+                        writer.close();
+                    }
+                    auto end = std::chrono::high_resolution_clock::now();
+                    result.mergeTime = std::chrono::duration<double, std::milli>(end - start).count();
+                    result.isCorrect = result.isCorrect && isValidRun(merged, expected);
+
+                    std::vector<std::int32_t> streamed;
+                    streamed.reserve(expected.size());
+                    start = std::chrono::high_resolution_clock::now();
+                    {
+                        SortedRunChunkSource<std::int32_t> sourceA(prefix(encodingA) + "_a.run");
+                        SortedRunChunkSource<std::int32_t> sourceB(prefix(encodingB) + "_b.run");
+                        StreamingMerge<std::int32_t> stream(sourceA, sourceB);
+                        while (auto chunk = stream.next()) {
+                            streamed.insert(streamed.end(), chunk->begin(), chunk->end());
+                        }
+                    }
+                    end = std::chrono::high_resolution_clock::now();
+                    result.streamTime = std::chrono::duration<double, std::milli>(end - start).count();
+                    result.isCorrect = result.isCorrect && streamed == expected;
+
+                    std::filesystem::remove(merged);
+                    results.push_back(result);
+                }
+            }
+
+            for (RunEncoding encoding : encodings) {
+                for (const char* suffix : {"_a.run", "_b.run", "_result.run"}) {
+                    std::filesystem::remove(prefix(encoding) + suffix);
+                }
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<RunFileResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(128, '-');
+        oss << "Sorted Run File Report (" << directory_ << "):\n" << separator << "\n";
+        oss << std::left
+            << std::setw(9)  << "SizeA"
+            << std::setw(9)  << "SizeB"
+            << std::setw(24) << "Case"
+            << std::setw(7)  << "Block"
+            << std::setw(14) << "Encodings"
+            << std::setw(12) << "Merge(ms)"
+            << std::setw(10) << "Copied"
+            << std::setw(10) << "Decoded"
+            << std::setw(13) << "Stream(ms)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(9)  << res.shape.sizeA
+                << std::setw(9)  << res.shape.sizeB
+                << std::setw(24) << toString(res.shape.caseType)
+                << std::setw(7)  << res.shape.fileBlockSize
+                << std::setw(14) << (name(res.encodingA) + "/" + name(res.encodingB))
+                << std::setw(12) << res.mergeTime
+                << std::setw(10) << res.stats.blocks_copied
+                << std::setw(10) << res.stats.blocks_decoded
+                << std::setw(13) << res.streamTime
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    std::string path(const std::string& name) const {
+        return (std::filesystem::path(directory_) / name).string();
+    }
+
+    std::string prefix(RunEncoding encoding) const {
+        return path(encoding == RunEncoding::Fixed ? "fixed" : "delta");
+    }
+
+    static std::string name(RunEncoding encoding) {
+        return encoding == RunEncoding::Fixed ? "fixed" : "delta";
+    }
+
+    static std::vector<std::int32_t> keys(const std::vector<CountingInt>& values) {
+        std::vector<std::int32_t> out;
+        out.reserve(values.size());
+        for (const auto& x : values) out.push_back(x.value);
+        return out;
+    }
+
+    // The merged file holds the expected keys, and its index entries (copied or written)
+    // describe the blocks they belong to.
+    static bool isValidRun(const std::string& file, const std::vector<std::int32_t>& expected) {
+        SortedRunReader<std::int32_t> reader(file);
+        if (reader.size() != expected.size()) return false;
+        std::vector<std::int32_t> all;
+        std::vector<std::int32_t> values;
+        for (std::size_t i = 0; i < reader.block_count(); ++i) {
+            reader.read_block(i, values);
+            const RunBlock<std::int32_t>& block = reader.block(i);
+            if (values.empty() || values.size() != block.count ||
+                values.front() != block.min || values.back() != block.max) {
+                return false;
+            }
+            all.insert(all.end(), values.begin(), values.end());
+        }
+        return all == expected;
+    }
+
+    std::string directory_;
+    std::vector<RunFileShape> shapes_;
+};
+
+#endif // RUN_FILE_BENCHMARK_HPP
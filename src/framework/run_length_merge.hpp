@@ -0,0 +1,25 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Declares the RunLengthMergeAlgorithm class.
+ */
+
+#ifndef RUN_LENGTH_MERGE_HPP
+#define RUN_LENGTH_MERGE_HPP
+
+#include <string>
+#include "merge_algorithm.hpp"
+#include "../algorithms/run_length_merge.hpp"
+
+template <typename T = CountingInt>
+class RunLengthMergeAlgorithm : public MergeAlgorithm<T> {
+public:
+    std::string getName() const override {
+        return "RunLengthMerge";
+    }
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
+        return run_length_merge(a, b);
+    }
+};
+
+#endif // RUN_LENGTH_MERGE_HPP
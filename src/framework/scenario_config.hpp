@@ -0,0 +1,315 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Builds test scenarios without recompiling: log-spaced size grids crossed
+ *              with corner cases, and scenario files in a simple INI format.
+ */
+
+#ifndef SCENARIO_CONFIG_HPP
+#define SCENARIO_CONFIG_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "test_scenarious.hpp"
+
+// Value range, block sizes, key count and distribution parameters shared by the
+// scenarios of a grid.
+struct ScenarioDefaults {
+    int randomMin = 0;
+    int randomMax = 1000000;
+    int blockSizeA = 5;
+    int blockSizeB = 5;
+    int distinctKeys = 16;
+    DistributionParams distribution;
+};
+
+/*
+ * Sets one scenario parameter by the name used in scenario files and --param:
+ * min, max, block_a, block_b, keys, zipf_s, clusters, cluster_width, step,
+ * gap_probability, max_gap, gap_mu, gap_sigma, ratio. Returns false for an unknown
+ * name; throws std::invalid_argument for a value that is not a number.
+ */
+inline bool applyScenarioParameter(ScenarioDefaults& values, const std::string& key, const std::string& value) {
+    auto toInt = [&]() {
+        size_t used = 0;
+        int result = std::stoi(value, &used);
+        if (used != value.size()) throw std::invalid_argument(value);
+        return result;
+    };
+    auto toDouble = [&]() {
+        size_t used = 0;
+        double result = std::stod(value, &used);
+        if (used != value.size()) throw std::invalid_argument(value);
+        return result;
+    };
+
+    DistributionParams& d = values.distribution;
+    try {
+        if (key == "min") values.randomMin = toInt();
+        else if (key == "max") values.randomMax = toInt();
+        else if (key == "block_a") values.blockSizeA = toInt();
+        else if (key == "block_b") values.blockSizeB = toInt();
+        else if (key == "keys") values.distinctKeys = toInt();
+        else if (key == "zipf_s") d.zipfExponent = toDouble();
+        else if (key == "clusters") d.clusters = toInt();
+        else if (key == "cluster_width") d.clusterWidth = toInt();
+        else if (key == "step") d.step = toInt();
+        else if (key == "gap_probability") d.gapProbability = toDouble();
+        else if (key == "max_gap") d.maxGap = toInt();
+        else if (key == "gap_mu") d.gapMu = toDouble();
+        else if (key == "gap_sigma") d.gapSigma = toDouble();
+        else if (key == "ratio") d.ratio = toInt();
+        else return false;
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument("invalid value for " + key + ": " + value);
+    }
+    return true;
+}
+
+// Scenario of the given sizes with the shared parameters. EXTREME_RATIO derives the size
+// of A from the size of B and the ratio.
+inline TestScenario makeScenario(int sizeA, int sizeB, CornerCaseType caseType, const ScenarioDefaults& defaults) {
+    TestScenario scenario{sizeA, sizeB, caseType, defaults.randomMin, defaults.randomMax,
+                          defaults.blockSizeA, defaults.blockSizeB, defaults.distinctKeys, defaults.distribution};
+    if (caseType == CornerCaseType::EXTREME_RATIO) {
+        scenario.sizeA = std::max(1, sizeB / std::max(1, defaults.distribution.ratio));
+    }
+    return scenario;
+}
+
+// Array size from "100000", "1e9" or "10^9"; throws std::invalid_argument.
+inline int parseSize(const std::string& text) {
+    // A number with nothing after it.
+    auto number = [](const std::string& part) {
+        size_t used = 0;
+        double value = std::stod(part, &used);
+        if (used != part.size()) throw std::invalid_argument(part);
+        return value;
+    };
+
+    double value = 0.0;
+    try {
+        std::string::size_type caret = text.find('^');
+        if (caret != std::string::npos) {
+            value = std::pow(number(text.substr(0, caret)), number(text.substr(caret + 1)));
+        } else {
+            value = number(text);
+        }
+    } catch (const std::logic_error&) {
+        throw std::invalid_argument("invalid size " + text);
+    }
+    if (value < 0 || value > INT_MAX || value != std::floor(value)) {
+        throw std::invalid_argument("size out of range " + text);
+    }
+    return static_cast<int>(value);
+}
+
+// Sizes lo, lo * 10^(1/p), lo * 10^(2/p), ... up to hi (hi included), rounded and
+// without duplicates; p is the number of points per decade.
+inline std::vector<int> logSpacedSizes(int lo, int hi, int pointsPerDecade = 1) {
+    if (lo < 1 || hi < lo || pointsPerDecade < 1) {
+        throw std::invalid_argument("size range needs 1 <= lo <= hi and at least one point per decade");
+    }
+    std::vector<int> sizes;
+    for (int k = 0;; k++) {
+        double value = std::round(lo * std::pow(10.0, static_cast<double>(k) / pointsPerDecade));
+        if (value > hi) break;
+        if (sizes.empty() || sizes.back() != static_cast<int>(value)) {
+            sizes.push_back(static_cast<int>(value));
+        }
+    }
+    if (sizes.back() != hi) {
+        sizes.push_back(hi);
+    }
+    return sizes;
+}
+
+// Sizes from "lo:hi[:points per decade]" (log-spaced) or "s1,s2,..." (as given).
+inline std::vector<int> parseSizes(const std::string& text) {
+    std::vector<std::string> parts;
+    char separator = text.find(':') != std::string::npos ? ':' : ',';
+    std::stringstream ss(text);
+    for (std::string part; std::getline(ss, part, separator);) {
+        parts.push_back(part);
+    }
+    if (parts.empty()) {
+        throw std::invalid_argument("empty size list");
+    }
+    if (separator == ':') {
+        if (parts.size() < 2 || parts.size() > 3) {
+            throw std::invalid_argument("size range must be lo:hi[:points per decade], got " + text);
+        }
+        return logSpacedSizes(parseSize(parts[0]), parseSize(parts[1]), parts.size() == 3 ? parseSize(parts[2]) : 1);
+    }
+    std::vector<int> sizes;
+    for (const auto& part : parts) {
+        sizes.push_back(parseSize(part));
+    }
+    return sizes;
+}
+
+// Corner cases from "RANDOM,PARTIAL_OVERLAP,..." or "all".
+inline std::vector<CornerCaseType> parseCornerCases(const std::string& text) {
+    if (text == "all") {
+        return allCornerCaseTypes();
+    }
+    std::vector<CornerCaseType> cases;
+    std::stringstream ss(text);
+    for (std::string name; std::getline(ss, name, ',');) {
+        cases.push_back(parseCornerCaseType(name));
+    }
+    return cases;
+}
+
+/*
+ * Scenarios of the grid sizesA x sizesB for every case (case outermost, then A, then B).
+ * Cases that fix the sizes are adjusted instead of failing: ONE_ELEMENT_EACH is added
+ * once, ONE_ARRAY_EMPTY and EXTREME_RATIO once per size of B, EQUAL_ARRAYS only where
+ * the sizes are equal.
+ */
+inline std::vector<TestScenario> makeGridScenarios(const std::vector<int>& sizesA, const std::vector<int>& sizesB,
+                                                   const std::vector<CornerCaseType>& cases,
+                                                   const ScenarioDefaults& defaults = {}) {
+    std::vector<TestScenario> scenarios;
+    for (CornerCaseType caseType : cases) {
+        for (int sizeA : sizesA) {
+            for (int sizeB : sizesB) {
+                TestScenario scenario = makeScenario(sizeA, sizeB, caseType, defaults);
+                if (caseType == CornerCaseType::ONE_ELEMENT_EACH) {
+                    scenario.sizeA = scenario.sizeB = 1;
+                } else if (caseType == CornerCaseType::ONE_ARRAY_EMPTY) {
+                    scenario.sizeA = 0;
+                } else if (caseType == CornerCaseType::EQUAL_ARRAYS && sizeA != sizeB) {
+                    continue;
+                }
+
+                bool duplicate = std::any_of(scenarios.begin(), scenarios.end(), [&](const TestScenario& s) {
+                    return s.caseType == scenario.caseType && s.sizeA == scenario.sizeA && s.sizeB == scenario.sizeB;
+                });
+                if (!duplicate) {
+                    scenarios.push_back(scenario);
+                }
+            }
+        }
+    }
+    return scenarios;
+}
+
+/*
+ * Loads scenarios from an INI file. '#' and ';' start comments. Sections:
+ *
+ *   [scenario]              one scenario
+ *   m = 1000                size of A
+ *   n = 100000              size of B
+ *   case = RANDOM           corner case (default RANDOM)
+ *
+ *   [grid]                  a grid, as makeGridScenarios
+ *   m = 100:100000:2        sizes of A: lo:hi[:points per decade] or a list s1,s2,...
+ *   n = 100,1000,1e9        sizes of B
+ *   case = RANDOM,PARTIAL_OVERLAP   corner cases, or "all" (default RANDOM)
+ *
+ * Both also take min, max, block_a, block_b and keys (defaults 0, 1000000, 5, 5, 16) and
+ * the parameters of the distribution cases (see applyScenarioParameter):
+ *
+ *   zipf_s = 1.2            ZIPF exponent, over `keys` keys
+ *   clusters = 16           CLUSTERED bursts ...
+ *   cluster_width = 1000    ... and the value range of each
+ *   step = 4                ARITHMETIC_GAPS common difference ...
+ *   gap_probability = 0.1   ... probability of missing terms before a value ...
+ *   max_gap = 64            ... and how many at most
+ *   gap_mu = 2              LOG_NORMAL_GAPS: log(gap) ~ N(mu, sigma)
+ *   gap_sigma = 1
+ *   ratio = 1000000         EXTREME_RATIO: m is n / ratio (m is ignored)
+ *
+ * Throws std::runtime_error with the file and line of the first error.
+ */
+inline std::vector<TestScenario> loadScenarioFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        throw std::runtime_error("unable to open scenario file " + path);
+    }
+
+    struct Section {
+        std::string kind;
+        int line = 0;
+        std::string m, n, cases = "RANDOM";
+        ScenarioDefaults values;
+    };
+
+    std::vector<TestScenario> scenarios;
+    Section section;
+
+    auto fail = [&](int line, const std::string& message) {
+        throw std::runtime_error(path + ":" + std::to_string(line) + ": " + message);
+    };
+    auto trim = [](std::string s) {
+        const char* blanks = " \t\r";
+        s.erase(0, s.find_first_not_of(blanks));
+        s.erase(s.find_last_not_of(blanks) + 1);
+        return s;
+    };
+    auto flush = [&]() {
+        if (section.kind.empty()) return;
+        if (section.m.empty() || section.n.empty()) {
+            fail(section.line, "[" + section.kind + "] needs m and n");
+        }
+        try {
+            if (section.kind == "scenario") {
+                TestScenario scenario = makeScenario(parseSize(section.m), parseSize(section.n),
+                                                     parseCornerCaseType(section.cases), section.values);
+                if (scenario.caseType == CornerCaseType::EQUAL_ARRAYS && scenario.sizeA != scenario.sizeB) {
+                    throw std::invalid_argument("EQUAL_ARRAYS needs m == n");
+                }
+                scenarios.push_back(scenario);
+            } else {
+                std::vector<TestScenario> grid = makeGridScenarios(parseSizes(section.m), parseSizes(section.n),
+                                                                   parseCornerCases(section.cases), section.values);
+                scenarios.insert(scenarios.end(), grid.begin(), grid.end());
+            }
+        } catch (const std::invalid_argument& e) {
+            fail(section.line, e.what());
+        }
+    };
+
+    std::string text;
+    for (int line = 1; std::getline(in, text); line++) {
+        text = trim(text.substr(0, text.find_first_of("#;")));
+        if (text.empty()) continue;
+
+        if (text.front() == '[') {
+            flush();
+            if (text != "[scenario]" && text != "[grid]") {
+                fail(line, "unknown section " + text);
+            }
+            section = Section{};
+            section.kind = text.substr(1, text.size() - 2);
+            section.line = line;
+            continue;
+        }
+
+        std::string::size_type eq = text.find('=');
+        if (eq == std::string::npos) fail(line, "expected key = value");
+        if (section.kind.empty()) fail(line, "key outside of a section");
+        std::string key = trim(text.substr(0, eq));
+        std::string value = trim(text.substr(eq + 1));
+
+        try {
+            if (key == "m") section.m = value;
+            else if (key == "n") section.n = value;
+            else if (key == "case") section.cases = value;
+            else if (!applyScenarioParameter(section.values, key, value)) fail(line, "unknown key " + key);
+        } catch (const std::invalid_argument& e) {
+            fail(line, e.what());
+        }
+    }
+    flush();
+    return scenarios;
+}
+
+#endif // SCENARIO_CONFIG_HPP
@@ -9,16 +9,17 @@
 #include "merge_algorithm.hpp"
 #include "../algorithms/algorithms.hpp"
 
-class SimpleKimKutznerMergeAlgorithm : public MergeAlgorithm {
+template <typename T = CountingInt>
+class SimpleKimKutznerMergeAlgorithm : public MergeAlgorithm<T> {
 public:
     std::string getName() const override {
         return "SimpleKimKutznerMerge";
     }
-    std::vector<CountingInt> merge(const std::vector<CountingInt>& a,
-                           const std::vector<CountingInt>& b) override {
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
 
-        std::vector<CountingInt> A = a;
-        std::vector<CountingInt> B = b;
+        std::vector<T> A = this->workingCopy(a);
+        std::vector<T> B = this->workingCopy(b);
 
         return simple_kim_kutzner_merge(A, B);
     }
@@ -0,0 +1,205 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Compares array-of-structs merging of wide records with the struct-of-arrays
+ *              front end (key-only merge plan + bulk payload gather).
+ */
+
+#ifndef SOA_BENCHMARK_HPP
+#define SOA_BENCHMARK_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/soa_merge.hpp"
+
+// Wide record for the array-of-structs baseline: one key plus P payload words of 8 bytes.
+template <std::size_t P>
+struct WideRecord {
+    std::int64_t key = 0;
+    std::array<std::uint64_t, P> payload{};
+
+    friend bool operator<(const WideRecord& l, const WideRecord& r)  { return l.key < r.key; }
+    friend bool operator>(const WideRecord& l, const WideRecord& r)  { return l.key > r.key; }
+    friend bool operator<=(const WideRecord& l, const WideRecord& r) { return l.key <= r.key; }
+    friend bool operator>=(const WideRecord& l, const WideRecord& r) { return l.key >= r.key; }
+    friend bool operator==(const WideRecord& l, const WideRecord& r) { return l.key == r.key; }
+    friend bool operator!=(const WideRecord& l, const WideRecord& r) { return l.key != r.key; }
+};
+
+struct SoaBenchmarkResult {
+    std::string algorithm;
+    int sizeA;
+    int sizeB;
+    std::size_t payloadColumns;
+    double aosTime;    // Merge of WideRecord vectors (ms).
+    double planTime;   // Key-only merge plan (ms).
+    double gatherTime; // Applying the plan to the key and payload columns (ms).
+    bool isCorrect;    // Every output row carries the payload of its key.
+};
+
+class SoaBenchmark {
+public:
+    void addShape(int sizeA, int sizeB) {
+        shapes_.push_back({sizeA, sizeB});
+    }
+
+    std::vector<SoaBenchmarkResult> run() {
+        std::vector<SoaBenchmarkResult> results;
+        for (const auto& [sizeA, sizeB] : shapes_) {
+            MergeTestCase test_case = generate_sorted_vectors(sizeA, sizeB, CornerCaseType::RANDOM, 0, 1000000);
+            runWidth<1>(test_case, results);
+            runWidth<4>(test_case, results);
+            runWidth<16>(test_case, results);
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<SoaBenchmarkResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(6);
+
+        const std::string separator(110, '-');
+        oss << "SoA Merge Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(9)  << "SizeA"
+            << std::setw(9)  << "SizeB"
+            << std::setw(9)  << "Columns"
+            << std::setw(13) << "AoS(ms)"
+            << std::setw(13) << "Plan(ms)"
+            << std::setw(13) << "Gather(ms)"
+            << std::setw(14) << "SoA total(ms)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.algorithm
+                << std::setw(9)  << res.sizeA
+                << std::setw(9)  << res.sizeB
+                << std::setw(9)  << res.payloadColumns
+                << std::setw(13) << res.aosTime
+                << std::setw(13) << res.planTime
+                << std::setw(13) << res.gatherTime
+                << std::setw(14) << res.planTime + res.gatherTime
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Keys    = std::vector<std::int64_t>;
+    using Payload = std::uint64_t;
+    using PlanFn  = std::function<MergePlan(const Keys&, const Keys&)>;
+
+    template <std::size_t P>
+    using AosMergeFn = std::function<std::vector<WideRecord<P>>(std::vector<WideRecord<P>>&, std::vector<WideRecord<P>>&)>;
+
+    // Payload words encode (source, index) so the output rows can be checked against the keys.
+    static Payload encodeRow(Slice source, std::size_t index, std::size_t column) {
+        return (static_cast<Payload>(source == Slice::B) << 63) | (static_cast<Payload>(index) << 8) | column;
+    }
+
+    template <std::size_t P>
+    static void buildInputs(const std::vector<CountingInt>& src, Slice slice,
+                            std::vector<WideRecord<P>>& aos, SoaTable<std::int64_t, Payload>& soa) {
+        aos.resize(src.size());
+        soa.keys.resize(src.size());
+        soa.columns.assign(P, std::vector<Payload>(src.size()));
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            aos[i].key = soa.keys[i] = src[i].value;
+            for (std::size_t c = 0; c < P; ++c) {
+                aos[i].payload[c] = soa.columns[c][i] = encodeRow(slice, i, c);
+            }
+        }
+    }
+
+    template <std::size_t P>
+    void runWidth(const MergeTestCase& test_case, std::vector<SoaBenchmarkResult>& results) {
+        std::vector<WideRecord<P>> aosA, aosB;
+        SoaTable<std::int64_t, Payload> soaA, soaB;
+        buildInputs<P>(test_case.a, Slice::A, aosA, soaA);
+        buildInputs<P>(test_case.b, Slice::B, aosB, soaB);
+
+        const std::vector<std::tuple<std::string, AosMergeFn<P>, PlanFn>> algorithms = {
+            {"TwoWayMerge",
+             [](auto& a, auto& b) { return two_way_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return two_way_merge_plan(a, b); }},
+            {"HwangLinStaticMerge",
+             [](auto& a, auto& b) { return hwang_lin_static_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return hwang_lin_static_merge_plan(a, b); }},
+            {"HwangLinDynamicMerge",
+             [](auto& a, auto& b) { return hwang_lin_dynamic_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return soa_hwang_lin_dynamic_plan(a, b); }},
+            {"HwangLinStaticKutznerMerge",
+             [](auto& a, auto& b) { return hwang_lin_static_kutzner_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return soa_hwang_lin_static_kutzner_plan(a, b); }},
+            {"SimpleKimKutznerMerge",
+             [](auto& a, auto& b) { return simple_kim_kutzner_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return soa_simple_kim_kutzner_plan(a, b); }},
+            {"UnstableCoreKimKutznerMerge",
+             [](auto& a, auto& b) { return unstable_core_kim_kutzner_merge(a, b); },
+             [](const Keys& a, const Keys& b) { return soa_unstable_core_kim_kutzner_plan(a, b); }},
+        };
+
+        for (const auto& [name, aosMerge, planFn] : algorithms) {
+            // The in-place algorithms consume their inputs, so each run gets fresh copies.
+            auto A = aosA;
+            auto B = aosB;
+            auto start = std::chrono::high_resolution_clock::now();
+            auto aosResult = aosMerge(A, B);
+            auto end = std::chrono::high_resolution_clock::now();
+            double aosTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+            start = std::chrono::high_resolution_clock::now();
+            MergePlan plan = planFn(soaA.keys, soaB.keys);
+            end = std::chrono::high_resolution_clock::now();
+            double planTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+            start = std::chrono::high_resolution_clock::now();
+            SoaTable<std::int64_t, Payload> soaResult;
+            soaResult.keys    = apply_merge_plan(plan, soaA.keys, soaB.keys);
+            soaResult.columns = apply_merge_plan_columns(plan, soaA.columns, soaB.columns);
+            end = std::chrono::high_resolution_clock::now();
+            double gatherTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+            bool isCorrect = aosResult.size() == soaResult.size() && isConsistent(soaResult, soaA, soaB);
+            for (std::size_t i = 0; isCorrect && i < aosResult.size(); ++i) {
+                isCorrect = aosResult[i].key == soaResult.keys[i];
+            }
+
+            results.push_back({name, static_cast<int>(test_case.a.size()), static_cast<int>(test_case.b.size()),
+                               P, aosTime, planTime, gatherTime, isCorrect});
+        }
+    }
+
+    // Checks that every output row's payload points back at an input row with the same key.
+    static bool isConsistent(const SoaTable<std::int64_t, Payload>& out,
+                             const SoaTable<std::int64_t, Payload>& a,
+                             const SoaTable<std::int64_t, Payload>& b) {
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            for (std::size_t c = 0; c < out.columns.size(); ++c) {
+                Payload word = out.columns[c][i];
+                const auto& keys = (word >> 63) ? b.keys : a.keys;
+                std::size_t index = static_cast<std::size_t>((word & ~(Payload{1} << 63)) >> 8);
+                if ((word & 0xff) != c || index >= keys.size() || keys[index] != out.keys[i]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::pair<int, int>> shapes_;
+};
+
+#endif // SOA_BENCHMARK_HPP
@@ -0,0 +1,189 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Benchmark of sorted_vector_set (staged inserts folded by Hwang-Lin merges)
+ *              against std::set and against a vector kept sorted by binary_insertion.
+ */
+
+#ifndef SORTED_VECTOR_SET_BENCHMARK_HPP
+#define SORTED_VECTOR_SET_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/sorted_vector_set.hpp"
+
+struct SortedVectorSetResult {
+    std::string container;
+    std::size_t elements;
+    double      insertTime;  // One insert per element, in random order (ms).
+    double      lookupTime;  // One lookup per element, half of them misses (ms).
+    double      bulkTime;    // All elements in one bulk insert (ms); 0 if not supported.
+    double      eraseTime;   // Erasing every other element as one batch (ms).
+    bool        isCorrect;   // Contents equal to the sorted input after inserts and after the erase.
+};
+
+class SortedVectorSetBenchmark {
+public:
+    // binary_insertion is quadratic, so it only runs for sizes up to binaryInsertionLimit.
+    explicit SortedVectorSetBenchmark(std::size_t binaryInsertionLimit = 100000)
+        : binaryInsertionLimit_(binaryInsertionLimit) {}
+
+    void addSize(std::size_t elements) {
+        sizes_.push_back(elements);
+    }
+
+    std::vector<SortedVectorSetResult> run() {
+        std::vector<SortedVectorSetResult> results;
+        for (std::size_t elements : sizes_) {
+            // Distinct even keys in random order; odd keys are the lookup misses.
+            Values keys(elements);
+            std::iota(keys.begin(), keys.end(), Value{0});
+            for (auto& key : keys) key *= 2;
+            std::mt19937 rng(static_cast<unsigned>(elements));
+            std::shuffle(keys.begin(), keys.end(), rng);
+
+            Values probes(elements);
+            for (std::size_t i = 0; i < elements; ++i) probes[i] = keys[i] + static_cast<Value>(i & 1);
+
+            Values expected = keys;
+            std::sort(expected.begin(), expected.end());
+            Values erased, remaining;
+            for (std::size_t i = 0; i < elements; ++i) (i % 2 ? erased : remaining).push_back(expected[i]);
+
+            results.push_back(runSortedVectorSet("sorted_vector_set", 0, keys, probes, expected, erased, remaining));
+            results.push_back(runSortedVectorSet("sorted_vector_set(stage=64)", 64, keys, probes, expected, erased, remaining));
+            results.push_back(runStdSet(keys, probes, expected, erased, remaining));
+            if (elements <= binaryInsertionLimit_) {
+                results.push_back(runBinaryInsertion(keys, probes, expected, erased, remaining));
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<SortedVectorSetResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Sorted Vector Set Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Container"
+            << std::setw(12) << "Elements"
+            << std::setw(14) << "Insert(ms)"
+            << std::setw(14) << "Lookup(ms)"
+            << std::setw(14) << "Bulk(ms)"
+            << std::setw(14) << "Erase(ms)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.container
+                << std::setw(12) << res.elements
+                << std::setw(14) << res.insertTime
+                << std::setw(14) << res.lookupTime
+                << std::setw(14) << res.bulkTime
+                << std::setw(14) << res.eraseTime
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Value = std::int32_t;
+    using Values = std::vector<Value>;
+    using Clock = std::chrono::high_resolution_clock;
+
+    static double elapsed(Clock::time_point start, Clock::time_point end) {
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    static SortedVectorSetResult runSortedVectorSet(const std::string& name, std::size_t stage,
+                                                    const Values& keys, const Values& probes,
+                                                    const Values& expected, const Values& erased,
+                                                    const Values& remaining) {
+        sorted_vector_set<Value> set(stage);
+        auto start = Clock::now();
+        for (Value key : keys) set.insert(key);
+        auto inserted = Clock::now();
+        std::size_t found = 0;
+        for (Value probe : probes) found += set.contains(probe);
+        auto looked = Clock::now();
+        bool isCorrect = found == (keys.size() + 1) / 2 && std::equal(set.begin(), set.end(), expected.begin(), expected.end());
+
+        sorted_vector_set<Value> bulk(stage);
+        auto bulkStart = Clock::now();
+        bulk.insert(keys.begin(), keys.end());
+        auto bulkEnd = Clock::now();
+        isCorrect = isCorrect && std::equal(bulk.begin(), bulk.end(), expected.begin(), expected.end());
+
+        auto eraseStart = Clock::now();
+        set.erase_batch(erased.begin(), erased.end());
+        auto eraseEnd = Clock::now();
+        isCorrect = isCorrect && std::equal(set.begin(), set.end(), remaining.begin(), remaining.end());
+
+        return {name, keys.size(), elapsed(start, inserted), elapsed(inserted, looked),
+                elapsed(bulkStart, bulkEnd), elapsed(eraseStart, eraseEnd), isCorrect};
+    }
+
+    static SortedVectorSetResult runStdSet(const Values& keys, const Values& probes, const Values& expected,
+                                           const Values& erased, const Values& remaining) {
+        std::set<Value> set;
+        auto start = Clock::now();
+        for (Value key : keys) set.insert(key);
+        auto inserted = Clock::now();
+        std::size_t found = 0;
+        for (Value probe : probes) found += set.count(probe);
+        auto looked = Clock::now();
+        bool isCorrect = found == (keys.size() + 1) / 2 && std::equal(set.begin(), set.end(), expected.begin(), expected.end());
+
+        std::set<Value> bulk;
+        auto bulkStart = Clock::now();
+        bulk.insert(keys.begin(), keys.end());
+        auto bulkEnd = Clock::now();
+        isCorrect = isCorrect && std::equal(bulk.begin(), bulk.end(), expected.begin(), expected.end());
+
+        auto eraseStart = Clock::now();
+        for (Value key : erased) set.erase(key);
+        auto eraseEnd = Clock::now();
+        isCorrect = isCorrect && std::equal(set.begin(), set.end(), remaining.begin(), remaining.end());
+
+        return {"std::set", keys.size(), elapsed(start, inserted), elapsed(inserted, looked),
+                elapsed(bulkStart, bulkEnd), elapsed(eraseStart, eraseEnd), isCorrect};
+    }
+
+    static SortedVectorSetResult runBinaryInsertion(const Values& keys, const Values& probes, const Values& expected,
+                                                    const Values& erased, const Values& remaining) {
+        Values vector;
+        auto start = Clock::now();
+        for (Value key : keys) binary_insertion(vector, key);
+        auto inserted = Clock::now();
+        std::size_t found = 0;
+        for (Value probe : probes) found += std::binary_search(vector.begin(), vector.end(), probe);
+        auto looked = Clock::now();
+        bool isCorrect = found == (keys.size() + 1) / 2 && vector == expected;
+
+        auto eraseStart = Clock::now();
+        Values kept;
+        std::set_difference(vector.begin(), vector.end(), erased.begin(), erased.end(), std::back_inserter(kept));
+        vector.swap(kept);
+        auto eraseEnd = Clock::now();
+        isCorrect = isCorrect && vector == remaining;
+
+        return {"vector+binary_insertion", keys.size(), elapsed(start, inserted), elapsed(inserted, looked),
+                0.0, elapsed(eraseStart, eraseEnd), isCorrect};
+    }
+
+    std::size_t              binaryInsertionLimit_;
+    std::vector<std::size_t> sizes_;
+};
+
+#endif // SORTED_VECTOR_SET_BENCHMARK_HPP
@@ -0,0 +1,198 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Checks and times StreamingMerge over in-memory and file chunk sources with
+ *              various chunk sizes and output bounds, against the expected result.
+ */
+
+#ifndef STREAMING_MERGE_BENCHMARK_HPP
+#define STREAMING_MERGE_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/streaming_merge.hpp"
+
+struct StreamingMergeShape {
+    int            sizeA;
+    int            sizeB;
+    CornerCaseType caseType;
+    int            blockSizeA = 2; // Block sizes of the generator (BLOCK_INTERLEAVE cases).
+    int            blockSizeB = 3;
+};
+
+struct StreamingMergeConfig {
+    std::size_t chunkSize;  // Elements per input chunk.
+    std::size_t maxOutput;  // StreamingMerge max_output.
+    std::size_t minForward; // StreamingMerge min_forward.
+};
+
+struct StreamingMergeResult {
+    StreamingMergeShape  shape;
+    StreamingMergeConfig config;
+    bool                 fromFile;   // FileChunkSource over int32 keys instead of VectorChunkSource.
+    double               time;       // Draining the merge (ms).
+    std::size_t          chunks;     // Output chunks.
+    std::size_t          forwarded;  // Elements forwarded without copying.
+    bool                 isCorrect;  // Output equals the expected result (keys, and origins for
+                                     // the vector source) and every chunk respects the bounds.
+};
+
+/*
+ * Every output chunk must hold 1 to max_output elements inside its owner; a forwarded
+ * chunk references an input chunk and holds at least min_forward elements, a copied one
+ * owns its whole buffer. Chunk sizes of 1 and 3 put a chunk boundary inside almost every
+ * Hwang-Lin block.
+ */
+class StreamingMergeBenchmark {
+public:
+    explicit StreamingMergeBenchmark(std::string directory = std::filesystem::temp_directory_path().string())
+        : directory_(std::move(directory)) {}
+
+    void addShape(const StreamingMergeShape& shape) {
+        shapes_.push_back(shape);
+    }
+
+    void addConfig(const StreamingMergeConfig& config) {
+        configs_.push_back(config);
+    }
+
+    std::vector<StreamingMergeResult> run() {
+        std::vector<StreamingMergeResult> results;
+        const std::string fileA = path("streaming_a.bin");
+        const std::string fileB = path("streaming_b.bin");
+        for (std::size_t i = 0; i < shapes_.size(); ++i) {
+            const StreamingMergeShape& shape = shapes_[i];
+            MergeTestCase test_case = generate_numbered_sorted_vectors(
+                i, shape.sizeA, shape.sizeB, shape.caseType, 0, 1000000, shape.blockSizeA, shape.blockSizeB, 16, {});
+            writeKeys(fileA, test_case.a);
+            writeKeys(fileB, test_case.b);
+
+            for (const auto& config : configs_) {
+                VectorChunkSource<CountingInt> vectorA(test_case.a, config.chunkSize);
+                VectorChunkSource<CountingInt> vectorB(test_case.b, config.chunkSize);
+                results.push_back(drain(shape, config, false, vectorA, vectorB, test_case.result.size(),
+                    [&](const CountingInt& x, std::size_t k) {
+                        const CountingInt& y = test_case.result[k];
+                        return x.value == y.value && x.source == y.source && x.index == y.index;
+                    }));
+
+                FileChunkSource<std::int32_t> fileSourceA(fileA, config.chunkSize);
+                FileChunkSource<std::int32_t> fileSourceB(fileB, config.chunkSize);
+                results.push_back(drain(shape, config, true, fileSourceA, fileSourceB, test_case.result.size(),
+                    [&](std::int32_t x, std::size_t k) { return x == test_case.result[k].value; }));
+            }
+        }
+        std::filesystem::remove(fileA);
+        std::filesystem::remove(fileB);
+        return results;
+    }
+
+    std::string generateReport(const std::vector<StreamingMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(120, '-');
+        oss << "Streaming Merge Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(9)  << "SizeA"
+            << std::setw(9)  << "SizeB"
+            << std::setw(24) << "Case"
+            << std::setw(8)  << "Source"
+            << std::setw(8)  << "Chunk"
+            << std::setw(9)  << "MaxOut"
+            << std::setw(8)  << "MinFwd"
+            << std::setw(11) << "Time(ms)"
+            << std::setw(11) << "Chunks"
+            << std::setw(15) << "Forwarded(%)"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            const std::size_t total = static_cast<std::size_t>(res.shape.sizeA) + res.shape.sizeB;
+            oss << std::left
+                << std::setw(9)  << res.shape.sizeA
+                << std::setw(9)  << res.shape.sizeB
+                << std::setw(24) << toString(res.shape.caseType)
+                << std::setw(8)  << (res.fromFile ? "file" : "vector")
+                << std::setw(8)  << res.config.chunkSize
+                << std::setw(9)  << res.config.maxOutput
+                << std::setw(8)  << res.config.minForward
+                << std::setw(11) << res.time
+                << std::setw(11) << res.chunks
+                << std::setw(15) << (total ? 100.0 * res.forwarded / total : 0.0)
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    std::string path(const std::string& name) const {
+        return (std::filesystem::path(directory_) / name).string();
+    }
+
+    // Raw int32 keys in native byte order, the input format of FileChunkSource.
+    static void writeKeys(const std::string& file, const std::vector<CountingInt>& values) {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("StreamingMergeBenchmark: unable to open " + file);
+        }
+        std::vector<std::int32_t> keys;
+        keys.reserve(values.size());
+        for (const auto& x : values) keys.push_back(x.value);
+        out.write(reinterpret_cast<const char*>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(std::int32_t)));
+        if (!out.flush()) {
+            throw std::runtime_error("StreamingMergeBenchmark: unable to write " + file);
+        }
+    }
+
+    // Drains the merge of `a` and `b`, comparing the k-th of the `total` output elements
+    // through `matches`.
+    template <typename T, typename Matches>
+    StreamingMergeResult drain(const StreamingMergeShape& shape, const StreamingMergeConfig& config, bool fromFile,
+                               ChunkSource<T>& a, ChunkSource<T>& b, std::size_t total, Matches matches) const {
+        StreamingMergeResult result{shape, config, fromFile, 0.0, 0, 0, true};
+        std::vector<StreamOutputChunk<T>> chunks;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        StreamingMerge<T> merge(a, b, config.maxOutput, config.minForward);
+        while (auto chunk = merge.next()) {
+            chunks.push_back(std::move(*chunk));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        result.time = std::chrono::duration<double, std::milli>(end - start).count();
+        result.chunks = chunks.size();
+
+        // Checked after the clock stops: the chunks share ownership of their elements.
+        std::size_t k = 0;
+        for (const auto& chunk : chunks) {
+            bool bounded = chunk.size() >= 1 && chunk.size() <= config.maxOutput &&
+                           chunk.offset + chunk.size() <= chunk.owner->size();
+            if (chunk.forwarded) {
+                bounded = bounded && chunk.size() >= config.minForward;
+                result.forwarded += chunk.size();
+            } else {
+                bounded = bounded && chunk.offset == 0 && chunk.size() == chunk.owner->size();
+            }
+            result.isCorrect = result.isCorrect && bounded;
+            for (const T* x = chunk.begin(); x != chunk.end() && result.isCorrect; ++x, ++k) {
+                result.isCorrect = k < total && matches(*x, k);
+            }
+        }
+        result.isCorrect = result.isCorrect && k == total;
+        return result;
+    }
+
+    std::string directory_;
+    std::vector<StreamingMergeShape> shapes_;
+    std::vector<StreamingMergeConfig> configs_;
+};
+
+#endif // STREAMING_MERGE_BENCHMARK_HPP
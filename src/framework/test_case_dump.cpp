@@ -0,0 +1,24 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Implements dump_merge_test_case.
+ */
+
+#include "test_case_dump.hpp"
+
+void dump_merge_test_case(const MergeTestCase& test_case,
+                          const std::string& prefix,
+                          RunEncoding encoding,
+                          std::uint32_t block_size)
+{
+    auto dump = [&](const std::vector<CountingInt>& values, const std::string& suffix, RunStability stability) {
+        SortedRunWriter<std::int32_t> writer(prefix + suffix, encoding, block_size, stability);
+        for (const auto& x : values) {
+            writer.push(x.value);
+        }
+        writer.close();
+    };
+
+    dump(test_case.a, "_a.run", RunStability::Unknown);
+    dump(test_case.b, "_b.run", RunStability::Unknown);
+    dump(test_case.result, "_result.run", RunStability::Stable);
+}
@@ -0,0 +1,29 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Writes generated test cases as sorted run files (see sorted_run_file.hpp).
+ */
+
+#ifndef TEST_CASE_DUMP_HPP
+#define TEST_CASE_DUMP_HPP
+
+#include <cstdint>
+#include <string>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/sorted_run_file.hpp"
+
+/**
+ * Dumps a test case into the sorted run file format: <prefix>_a.run, <prefix>_b.run
+ * and <prefix>_result.run. Only the key values are stored (as int32); the result is
+ * tagged as stable since it is produced by std::merge.
+ *
+ * @param test_case  Test case to dump.
+ * @param prefix     Path prefix of the three files.
+ * @param encoding   (Optional) Block encoding, default delta/varint.
+ * @param block_size (Optional) Elements per block, default 4096.
+ */
+void dump_merge_test_case(const MergeTestCase& test_case,
+                          const std::string& prefix,
+                          RunEncoding encoding = RunEncoding::DeltaVarint,
+                          std::uint32_t block_size = 4096);
+
+#endif // TEST_CASE_DUMP_HPP
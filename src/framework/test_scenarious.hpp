@@ -7,7 +7,13 @@
 #ifndef TEST_CONFIG_HPP
 #define TEST_CONFIG_HPP
 
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
 #include "generate_sorted_vectors.hpp"
+#include "perf_counters.hpp"
+#include "allocation_tracker.hpp"
 
 // Structure for describing a single test scenario
 struct TestScenario {
@@ -18,15 +24,118 @@ struct TestScenario {
     int randomMax;
     int blockSizeA;
     int blockSizeB;
+    int distinctKeys = 16;  // Number of distinct keys (LOW_CARDINALITY and ZIPF).
+    DistributionParams distribution = {};  // Parameters of the distribution cases.
+};
+
+// Shortest form of a parameter for case names ("0.1", "1.2", "64").
+inline std::string formatParameter(double value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+}
+
+// Case name for reports: the corner case with its parameters. No commas, so it can go
+// into CSV files unquoted.
+inline std::string caseName(const TestScenario& scenario) {
+    const DistributionParams& d = scenario.distribution;
+    const std::string name = toString(scenario.caseType);
+    switch (scenario.caseType) {
+    case CornerCaseType::LOW_CARDINALITY:
+        return name + "(" + std::to_string(scenario.distinctKeys) + ")";
+    case CornerCaseType::ZIPF:
+        return name + "(keys=" + std::to_string(scenario.distinctKeys) + " s=" + formatParameter(d.zipfExponent) + ")";
+    case CornerCaseType::CLUSTERED:
+        return name + "(" + std::to_string(d.clusters) + "x" + std::to_string(d.clusterWidth) + ")";
+    case CornerCaseType::ARITHMETIC_GAPS:
+        return name + "(step=" + std::to_string(d.step) + " p=" + formatParameter(d.gapProbability) +
+               " max=" + std::to_string(d.maxGap) + ")";
+    case CornerCaseType::LOG_NORMAL_GAPS:
+        return name + "(mu=" + formatParameter(d.gapMu) + " sigma=" + formatParameter(d.gapSigma) + ")";
+    case CornerCaseType::EXTREME_RATIO:
+        return name + "(1:" + std::to_string(d.ratio) + ")";
+    default:
+        return name;
+    }
+}
+
+// Everything the test data of a scenario depends on besides the seed, as text.
+inline std::string scenarioKey(const TestScenario& scenario) {
+    const DistributionParams& d = scenario.distribution;
+    std::ostringstream key;
+    key << std::setprecision(17)
+        << "m=" << scenario.sizeA << " n=" << scenario.sizeB << " case=" << toString(scenario.caseType)
+        << " min=" << scenario.randomMin << " max=" << scenario.randomMax
+        << " block_a=" << scenario.blockSizeA << " block_b=" << scenario.blockSizeB
+        << " keys=" << scenario.distinctKeys
+        << " zipf_s=" << d.zipfExponent << " clusters=" << d.clusters << " cluster_width=" << d.clusterWidth
+        << " step=" << d.step << " gap_probability=" << d.gapProbability << " max_gap=" << d.maxGap
+        << " gap_mu=" << d.gapMu << " gap_sigma=" << d.gapSigma << " ratio=" << d.ratio;
+    return key.str();
+}
+
+// FNV-1a hash of a key.
+inline std::uint64_t hashKey(const std::string& key) {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Test case number of a run of the scenario (see generate_numbered_sorted_vectors): a hash
+// of the scenario and the run index, so with a fixed seed run r of a scenario gets the same
+// data in every algorithm and every process, however many runs came before it.
+inline std::uint64_t testCaseNumber(const TestScenario& scenario, int run) {
+    return hashKey(scenarioKey(scenario) + " run=" + std::to_string(run)) >> 2;
+}
+
+// Test data of run `run` of the scenario.
+inline MergeTestCase generateTestCase(const TestScenario& scenario, int run) {
+    return generate_numbered_sorted_vectors(testCaseNumber(scenario, run),
+                                            scenario.sizeA, scenario.sizeB, scenario.caseType,
+                                            scenario.randomMin, scenario.randomMax,
+                                            scenario.blockSizeA, scenario.blockSizeB,
+                                            scenario.distinctKeys, scenario.distribution);
+}
+
+// Repetition policy of AlgorithmTester: every scenario is run `warmup` times untimed, then
+// timed on fresh data until the 95% confidence interval of the mean is narrower than
+// `relativeCI` times the mean (checked from `minRepetitions` on) or `maxRepetitions` is reached.
+// Run r of a scenario always gets the same data for a given seed; comparison, operation and
+// allocation counts are averaged over the first `minRepetitions` timed runs only, so they are
+// reproducible while the number of repetitions (and the times) follow the machine.
+struct TimingConfig {
+    int warmup = 2;
+    int minRepetitions = 5;
+    int maxRepetitions = 30;
+    double relativeCI = 0.05;
+};
+
+// Timing statistics of the measured repetitions of one scenario (in ms).
+struct TimingStats {
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double stddev = 0.0;
+    int repetitions = 0;
 };
 
 // Structure for storing the results of one test scenario.
 struct TestScenarioResult {
     TestScenario scenario;  // The test scenario configuration.
-    double time;            // Execution time (in ms).
-    long long compressions; // Number of compression operations.
+    double time;            // Execution time (in ms): median of the measured repetitions.
+    long long compressions; // Number of compression operations (mean per repetition).
     bool isCorrect;         // Flag indicating if all iterations matched the expected results.
     bool isStable;          // Flag indicating whether the merge algorithm is stable (i.e., if equal elements preserve their input order).
+    TimingStats timing;     // Distribution of the execution time over the repetitions.
+    std::string keyType;    // Element type the time was measured on (comparisons are on CountingInt).
+    PerfCounterValues counters; // Hardware counters of the timed call (mean per repetition; -1 if unavailable).
+    ElementOperations operations; // Element copies, moves and swaps of the CountingInt pass (mean per repetition).
+    AllocationStats allocations;  // Heap use of the timed algorithm, from untimed calls (mean per repetition; peak is the maximum).
+    std::uint64_t seed = 0;       // Seed of the test data generator (reproduces the run with --seed).
 };
 
 #endif // TEST_CONFIG_HPP
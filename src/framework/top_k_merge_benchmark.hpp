@@ -0,0 +1,137 @@
+/*
+ * Author: Sergei Gorlov.
+ * Description: Benchmark of top-k and rank-range merges against a full merge followed by
+ *              taking the window.
+ */
+
+#ifndef TOP_K_MERGE_BENCHMARK_HPP
+#define TOP_K_MERGE_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "generate_sorted_vectors.hpp"
+#include "../algorithms/algorithms.hpp"
+#include "../algorithms/top_k_merge.hpp"
+
+struct TopKMergeResult {
+    std::string algorithm;
+    int         sizeA;
+    int         sizeB;
+    std::size_t lo;          // Window [lo, lo + count) of the merged sequence.
+    std::size_t count;
+    double      time;        // ms
+    long long   comparisons;
+    bool        isCorrect;   // Equal to the window of a full stable merge.
+};
+
+class TopKMergeBenchmark {
+public:
+    void addShape(int sizeA, int sizeB) {
+        shapes_.push_back({sizeA, sizeB});
+    }
+
+    void addWindow(std::size_t count) {
+        counts_.push_back(count);
+    }
+
+    std::vector<TopKMergeResult> run() {
+        std::vector<TopKMergeResult> results;
+        for (const auto& shape : shapes_) {
+            MergeTestCase testCase = generate_sorted_vectors(shape.sizeA, shape.sizeB, CornerCaseType::RANDOM, 0, 1000000);
+            Values& a = testCase.a;
+            Values& b = testCase.b;
+            for (std::size_t i = 0; i < a.size(); ++i) a[i].index = static_cast<int>(i);
+            for (std::size_t i = 0; i < b.size(); ++i) b[i].index = static_cast<int>(i);
+
+            Values expected(a.size() + b.size());
+            std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+
+            for (std::size_t count : counts_) {
+                // The first `count` elements, and `count` elements from the middle.
+                for (std::size_t lo : {std::size_t{0}, expected.size() / 2}) {
+                    const std::size_t hi = std::min(lo + count, expected.size());
+                    Values window(expected.begin() + lo, expected.begin() + hi);
+
+                    results.push_back(measure("two_way_merge (full)", shape, lo, count, window, [&] {
+                        Values merged = two_way_merge(a, b);
+                        return Values(merged.begin() + lo, merged.begin() + hi);
+                    }));
+                    results.push_back(measure(lo == 0 ? "top_k_merge" : "rank_range_merge", shape, lo, count, window, [&] {
+                        return rank_range_merge(a, b, lo, hi);
+                    }));
+                    results.push_back(measure(lo == 0 ? "hwang_lin_top_k_merge" : "hwang_lin_rank_range_merge",
+                                              shape, lo, count, window, [&] {
+                        return hwang_lin_rank_range_merge(a, b, lo, hi);
+                    }));
+                }
+            }
+        }
+        return results;
+    }
+
+    std::string generateReport(const std::vector<TopKMergeResult>& results) const {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(3);
+
+        const std::string separator(110, '-');
+        oss << "Top-k / Rank-Range Merge Report:\n" << separator << "\n";
+        oss << std::left
+            << std::setw(30) << "Algorithm"
+            << std::setw(10) << "Size A"
+            << std::setw(10) << "Size B"
+            << std::setw(10) << "Lo"
+            << std::setw(10) << "Count"
+            << std::setw(12) << "Time(ms)"
+            << std::setw(14) << "Comparisons"
+            << "Result\n" << separator << "\n";
+
+        for (const auto& res : results) {
+            oss << std::left
+                << std::setw(30) << res.algorithm
+                << std::setw(10) << res.sizeA
+                << std::setw(10) << res.sizeB
+                << std::setw(10) << res.lo
+                << std::setw(10) << res.count
+                << std::setw(12) << res.time
+                << std::setw(14) << res.comparisons
+                << (res.isCorrect ? "Correct" : "Incorrect") << "\n";
+        }
+        oss << separator << "\n";
+        return oss.str();
+    }
+
+private:
+    using Values = std::vector<CountingInt>;
+
+    struct Shape {
+        int sizeA;
+        int sizeB;
+    };
+
+    static TopKMergeResult measure(const std::string& name, const Shape& shape, std::size_t lo, std::size_t count,
+                                   const Values& expected, const std::function<Values()>& merge) {
+        CountingInt::resetCounter();
+        auto start = std::chrono::high_resolution_clock::now();
+        Values result = merge();
+        auto end = std::chrono::high_resolution_clock::now();
+        const long long comparisons = CountingInt::comparisons;
+
+        bool isCorrect = std::equal(result.begin(), result.end(), expected.begin(), expected.end(),
+            [](const CountingInt& x, const CountingInt& y) {
+                return x.value == y.value && x.source == y.source && x.index == y.index;
+            });
+
+        return {name, shape.sizeA, shape.sizeB, lo, count,
+                std::chrono::duration<double, std::milli>(end - start).count(), comparisons, isCorrect};
+    }
+
+    std::vector<Shape>       shapes_;
+    std::vector<std::size_t> counts_;
+};
+
+#endif // TOP_K_MERGE_BENCHMARK_HPP
@@ -10,15 +10,20 @@
 #include "merge_algorithm.hpp"
 #include "../algorithms/algorithms.hpp"
 
-class TwoWayMergeAlgorithm : public MergeAlgorithm {
+template <typename T = CountingInt>
+class TwoWayMergeAlgorithm : public MergeAlgorithm<T> {
 public:
     std::string getName() const override {
         return "TwoWayMerge";
     }
-    std::vector<CountingInt> merge(const std::vector<CountingInt>& a,
-                           const std::vector<CountingInt>& b) override {
+    std::vector<T> merge(const std::vector<T>& a,
+                           const std::vector<T>& b) override {
         return two_way_merge(a, b);
     }
+    MergePlan mergePlan(const std::vector<T>& a,
+                        const std::vector<T>& b) override {
+        return two_way_merge_plan(a, b);
+    }
 };
 
 #endif // TWO_WAY_MERGE_HPP
@@ -1,5 +1,9 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <filesystem>
+#include <regex>
 #include <vector>
 #include <string>
 #include "framework/generate_sorted_vectors.hpp"
@@ -15,25 +19,458 @@
 #include "framework/algorithm_tester.hpp"
 #include "framework/two_way_merge.hpp"
 #include "framework/split_merge.hpp"   
+#include "framework/run_length_merge.hpp"
+#include "framework/hwang_lin_tail_merge.hpp"
+#include "framework/soa_benchmark.hpp"
+#include "framework/external_merge_benchmark.hpp"
+#include "framework/run_file_benchmark.hpp"
+#include "framework/streaming_merge_benchmark.hpp"
+#include "framework/merge_view_benchmark.hpp"
+#include "framework/batch_merge_benchmark.hpp"
+#include "framework/parallel_merge_benchmark.hpp"
+#include "framework/output_buffer_benchmark.hpp"
+#include "framework/sorted_vector_set_benchmark.hpp"
+#include "framework/async_merge_benchmark.hpp"
+#include "framework/top_k_merge_benchmark.hpp"
+#include "framework/merge_select_benchmark.hpp"
+#include "framework/scenario_config.hpp"
+#include "framework/dataset_cache.hpp"
+#include "framework/test_case_dump.hpp"
 
+// Format of the grid results on stdout; --csv <dir> writes CSV files in either case.
 enum class OutputFormat {
     Console,
-    CsvFile
+    Csv
 };
 
+// Element type the grid is timed on; comparisons are always counted on CountingInt.
+enum class KeyType {
+    Int32,
+    Int64,
+    Double,
+    Counting
+};
+
+// All merge algorithms of the comparison grid, instantiated for element type T.
+template <typename T>
+static std::vector<std::unique_ptr<MergeAlgorithm<T>>> makeAlgorithms() {
+    std::vector<std::unique_ptr<MergeAlgorithm<T>>> algorithms;
+    algorithms.push_back(std::make_unique<TwoWayMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinDynamicMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinDynamicStableMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinKnuthMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinStaticMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinStaticKutznerMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<HwangLinStaticStableMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<FractialInsertionMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<SimpleKimKutznerMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<SplitMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<UnstableCoreKimKutznerMergeAlgorithm<T>>());
+    algorithms.push_back(std::make_unique<RunLengthMergeAlgorithm<T>>());
+    for (TailMergeVariant variant : {TailMergeVariant::Static, TailMergeVariant::StaticStable,
+                                     TailMergeVariant::Knuth, TailMergeVariant::KnuthStable,
+                                     TailMergeVariant::Dynamic, TailMergeVariant::DynamicStable}) {
+        algorithms.push_back(std::make_unique<HwangLinTailMergeAlgorithm<T>>(variant));
+    }
+    return algorithms;
+}
+
+// Runs the algorithms of the grid whose name matches `filter`, timed on T keys, and prints
+// the reports (or CSV rows); with an output directory also writes one CSV file per algorithm.
+template <typename T>
+static void runAlgorithms(AlgorithmTester& tester, const std::regex& filter,
+                          OutputFormat output, const std::string& outputDirName) {
+    std::vector<std::unique_ptr<MergeAlgorithm<T>>> algorithms = makeAlgorithms<T>();
+    std::vector<std::unique_ptr<MergeAlgorithm<CountingInt>>> counted = makeAlgorithms<CountingInt>();
+
+    const std::string separator(REPORT_WIDTH, '=');
+    bool csvHeader = true;
+
+    // Iterate over each algorithm and run the tests.
+    for (std::size_t i = 0; i < algorithms.size(); i++) {
+        auto& alg = algorithms[i];
+        if (!std::regex_search(alg->getName(), filter)) {
+            continue;
+        }
+
+        if (output == OutputFormat::Console) {
+            std::cout << separator << std::endl;
+            std::cout << "Testing algorithm: " << alg->getName() << std::endl;
+            std::cout << separator << std::endl;
+        }
+
+        auto results = tester.runTests(*alg, *counted[i]);
+        if (output == OutputFormat::Console) {
+            std::string report = tester.generateReport(results);
+            std::cout << report << std::endl;
+        } else {
+            tester.writeCSV(std::cout, results, csvHeader, alg->getName());
+            csvHeader = false;
+        }
+
+        if (!outputDirName.empty()) {
+            std::string filePath = outputDirName;
+            if (filePath.back() != '/' && filePath.back() != '\\') {
+                filePath += '/';
+            }
+
+            filePath += alg->getName() + ".csv";
+
+            tester.generateCSV(filePath, { results });
+        }
+    }
+}
+
+static void printUsage(const char* program) {
+    std::cout
+        << "Usage: " << program << " [options]\n"
+        << "\n"
+        << "Merge grid (default: M in 10^2..10^5, N in {1, 5} x 10^2..10^5, RANDOM):\n"
+        << "  --algorithms <regex>     run only algorithms whose name matches (ECMAScript regex)\n"
+        << "  --m <sizes>              sizes of A: lo:hi[:points per decade] (log-spaced) or s1,s2,...\n"
+        << "  --n <sizes>              sizes of B, same syntax; sizes up to 10^9 (1e9 and 10^9 accepted)\n"
+        << "  --cases <list>           corner cases, comma-separated, or \"all\" (default RANDOM)\n"
+        << "  --param <key>=<value>    scenario parameter, repeatable: keys, zipf_s, clusters,\n"
+        << "                           cluster_width, step, gap_probability, max_gap, gap_mu,\n"
+        << "                           gap_sigma, ratio, min, max, block_a, block_b\n"
+        << "  --scenarios <file>       scenarios from an INI file ([scenario] and [grid] sections)\n"
+        << "  --low-cardinality        LOW_CARDINALITY scenarios with 2, 16 and 256 keys instead of the grid\n"
+        << "  --seed <n>               seed of the test data generator (default: random; see CSV)\n"
+        << "  --repetitions <n>        exactly n timed repetitions per scenario (default: 5..30, 5% CI)\n"
+        << "  --warmup <n>             untimed runs before the timed ones (default 2)\n"
+        << "  --key-type <type>        timed element type: int32 (default), int64, double, counting\n"
+        << "  --format <format>        stdout format: console (default) or csv\n"
+        << "  --csv <dir>              also write <dir>/<algorithm>.csv\n"
+        << "  --dump-runs <dir>        write the scenarios as sorted run files instead of running\n"
+        << "  --dataset-cache <dir>    keep the test data in <dir> and share it between algorithms;\n"
+        << "                           with --seed, later runs map it instead of generating it\n"
+        << "  --dataset-cache-tmpfs    require the cache on tmpfs (default dir " << DatasetCache::tmpfsDirectory << ")\n"
+        << "  --datasets <n>           datasets per scenario in the cache, cycled over the runs; default:\n"
+        << "                           one per run (fresh data every repetition, as without the cache),\n"
+        << "                           fewer save disk space and generation time but repeat inputs\n"
+        << "  --dataset-memory <MiB>   datasets kept in memory for all algorithms (default: half of RAM);\n"
+        << "                           the rest are mapped from their files on every load\n"
+        << "\n"
+        << "Other benchmarks (one per run):\n"
+        << "  --soa, --batch, --parallel, --output-buffer, --sorted-set, --async, --top-k,\n"
+        << "  --select, --streaming, --views, --external <dir>, --run-files <dir>\n"
+        << "  --threads <n>            threads of the test data generator (default: all cores)\n"
+        << "                           and of --parallel (default: 1 to 64)\n";
+}
+
 int main(int argc, char* argv[]) {
     OutputFormat output = OutputFormat::Console;
     std::string outputDirName;
+    std::regex algorithmFilter(".*");
+    std::string sizesA;
+    std::string sizesB;
+    std::string caseList;
+    ScenarioDefaults scenarioDefaults;
+    std::string scenarioFileName;
+    TimingConfig timing;
+    std::size_t threads = 0;
+    bool runSoa = false;
+    bool runBatch = false;
+    bool runParallel = false;
+    bool runOutputBuffer = false;
+    bool runSortedSet = false;
+    bool runAsync = false;
+    bool runTopK = false;
+    bool runSelect = false;
+    bool runLowCardinality = false;
+    bool runStreaming = false;
+    bool runViews = false;
+    std::string externalDirName;
+    std::string runFileDirName;
+    std::string dumpDirName;
+    std::string datasetCacheDirName;
+    bool datasetCacheTmpfs = false;
+    int datasetsPerScenario = 0;
+    std::size_t datasetMemoryMiB = 0;
+    KeyType keyType = KeyType::Int32;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            // Value of an option that takes one.
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--csv") {
+                outputDirName = value();
+            } else if (arg == "--format") {
+                std::string name = value();
+                if (name == "console") {
+                    output = OutputFormat::Console;
+                } else if (name == "csv") {
+                    output = OutputFormat::Csv;
+                } else {
+                    throw std::invalid_argument("unknown format " + name + " (console, csv)");
+                }
+            } else if (arg == "--algorithms") {
+                algorithmFilter = std::regex(value());
+            } else if (arg == "--m") {
+                sizesA = value();
+            } else if (arg == "--n") {
+                sizesB = value();
+            } else if (arg == "--cases") {
+                caseList = value();
+            } else if (arg == "--param") {
+                std::string parameter = value();
+                std::string::size_type eq = parameter.find('=');
+                if (eq == std::string::npos ||
+                    !applyScenarioParameter(scenarioDefaults, parameter.substr(0, eq), parameter.substr(eq + 1))) {
+                    throw std::invalid_argument("unknown parameter " + parameter + " (see --help)");
+                }
+            } else if (arg == "--scenarios") {
+                scenarioFileName = value();
+            } else if (arg == "--seed") {
+                seed_sorted_vectors(std::stoull(value()));
+            } else if (arg == "--repetitions") {
+                timing.minRepetitions = timing.maxRepetitions = std::stoi(value());
+                if (timing.maxRepetitions < 1) {
+                    throw std::invalid_argument("--repetitions must be at least 1");
+                }
+            } else if (arg == "--warmup") {
+                timing.warmup = std::stoi(value());
+            } else if (arg == "--threads") {
+                threads = std::stoul(value());
+                if (threads == 0) {
+                    throw std::invalid_argument("--threads must be at least 1");
+                }
+                set_sorted_vectors_threads(static_cast<unsigned int>(threads));
+            } else if (arg == "--soa") {
+                runSoa = true;
+            } else if (arg == "--batch") {
+                runBatch = true;
+            } else if (arg == "--parallel") {
+                runParallel = true;
+            } else if (arg == "--output-buffer") {
+                runOutputBuffer = true;
+            } else if (arg == "--sorted-set") {
+                runSortedSet = true;
+            } else if (arg == "--async") {
+                runAsync = true;
+            } else if (arg == "--top-k") {
+                runTopK = true;
+            } else if (arg == "--select") {
+                runSelect = true;
+            } else if (arg == "--low-cardinality") {
+                runLowCardinality = true;
+            } else if (arg == "--streaming") {
+                runStreaming = true;
+            } else if (arg == "--views") {
+                runViews = true;
+            } else if (arg == "--external") {
+                externalDirName = value();
+            } else if (arg == "--run-files") {
+                runFileDirName = value();
+            } else if (arg == "--dump-runs") {
+                dumpDirName = value();
+            } else if (arg == "--dataset-cache") {
+                datasetCacheDirName = value();
+            } else if (arg == "--dataset-cache-tmpfs") {
+                datasetCacheTmpfs = true;
+            } else if (arg == "--datasets") {
+                datasetsPerScenario = std::stoi(value());
+                if (datasetsPerScenario < 1) {
+                    throw std::invalid_argument("--datasets must be at least 1");
+                }
+            } else if (arg == "--dataset-memory") {
+                datasetMemoryMiB = static_cast<std::size_t>(parseSize(value()));
+                if (datasetMemoryMiB == 0) {
+                    throw std::invalid_argument("--dataset-memory must be at least 1");
+                }
+            } else if (arg == "--key-type") {
+                std::string name = value();
+                if (name == "int32") {
+                    keyType = KeyType::Int32;
+                } else if (name == "int64") {
+                    keyType = KeyType::Int64;
+                } else if (name == "double") {
+                    keyType = KeyType::Double;
+                } else if (name == "counting") {
+                    keyType = KeyType::Counting;
+                } else {
+                    throw std::invalid_argument("unknown key type " + name + " (int32, int64, double, counting)");
+                }
+            } else {
+                throw std::invalid_argument("unknown option " + arg + " (see --help)");
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Struct-of-arrays benchmark: 1, 4 and 16 payload columns of 8 bytes each.
+    if (runSoa) {
+        SoaBenchmark soa;
+        soa.addShape(1000, 100000);
+        soa.addShape(10000, 100000);
+        soa.addShape(100000, 100000);
+        std::cout << soa.generateReport(soa.run()) << std::endl;
+        return 0;
+    }
+
+    // Many small independent merges: 100000 merges with |A|, |B| in [10, 1000].
+    if (runBatch) {
+        BatchMergeBenchmark batch(100000, 10, 1000);
+        std::cout << batch.generateReport(batch.run()) << std::endl;
+        return 0;
+    }
+
+    // Parallel merges on the work-stealing scheduler, 1 to 64 threads.
+    if (runParallel) {
+        ParallelMergeBenchmark parallel = threads == 0 ? ParallelMergeBenchmark() : ParallelMergeBenchmark({threads});
+        parallel.addShape(1000000, 1000000);
+        parallel.addShape(100000, 1900000);
+        std::cout << parallel.generateReport(parallel.run()) << std::endl;
+        return 0;
+    }
+
+    // Output storage of the out-of-place merges: value-initialized vector vs. OutputBuffer.
+    if (runOutputBuffer) {
+        OutputBufferBenchmark outputBuffer;
+        outputBuffer.addShape(10000000, 10000000);
+        outputBuffer.addShape(100000, 19900000);
+        std::cout << outputBuffer.generateReport(outputBuffer.run()) << std::endl;
+        return 0;
+    }
+
+    // sorted_vector_set against std::set and binary_insertion on a vector.
+    if (runSortedSet) {
+        SortedVectorSetBenchmark sortedSet;
+        sortedSet.addSize(10000);
+        sortedSet.addSize(100000);
+        sortedSet.addSize(1000000);
+        std::cout << sortedSet.generateReport(sortedSet.run()) << std::endl;
+        return 0;
+    }
+
+    // Coroutine merge of streams from producers with random delays; fast and slow consumers.
+    if (runAsync) {
+        AsyncMergeBenchmark async;
+        async.addScenario({4, 100000, 1024, 200, 0, 4});
+        async.addScenario({4, 100000, 1024, 200, 2000, 4});
+        async.addScenario({4, 100000, 1024, 200, 2000, 16});
+        async.addScenario({16, 10000, 256, 100, 500, 2});
+        std::cout << async.generateReport(async.run()) << std::endl;
+        return 0;
+    }
+
+    // Top-k and rank-range merges against a full merge, k from 10 to 100000.
+    if (runTopK) {
+        TopKMergeBenchmark topK;
+        topK.addShape(1000000, 1000000);
+        topK.addShape(10000, 1990000);
+        topK.addWindow(10);
+        topK.addWindow(1000);
+        topK.addWindow(100000);
+        std::cout << topK.generateReport(topK.run()) << std::endl;
+        return 0;
+    }
+
+    // Co-rank selection: per-rank and batched merge_select against a full merge.
+    if (runSelect) {
+        MergeSelectBenchmark select;
+        select.addShape(1000000, 1000000);
+        select.addShape(10000, 1990000);
+        select.addQueryCount(1);
+        select.addQueryCount(100);
+        select.addQueryCount(10000);
+        std::cout << select.generateReport(select.run()) << std::endl;
+        return 0;
+    }
+
+    // Streaming merge over in-memory and file chunks: chunk sizes 1 to 4096, small and large
+    // output bounds.
+    if (runStreaming) {
+        StreamingMergeBenchmark streaming;
+        streaming.addShape({1000, 100000, CornerCaseType::RANDOM});
+        streaming.addShape({100000, 100000, CornerCaseType::BLOCK_INTERLEAVE_A_B, 1000, 1000});
+        streaming.addShape({10000, 10000, CornerCaseType::DUPLICATES_IN_BOTH});
+        streaming.addShape({10000, 10000, CornerCaseType::FIRST_ALL_GREATER});
+        streaming.addShape({0, 10000, CornerCaseType::ONE_ARRAY_EMPTY});
+        streaming.addConfig({1, 4096, 64});
+        streaming.addConfig({3, 4096, 64});
+        streaming.addConfig({64, 4096, 64});
+        streaming.addConfig({4096, 4096, 64});
+        streaming.addConfig({64, 16, 4});
+        streaming.addConfig({3, 8, 1});
+        try {
+            std::cout << streaming.generateReport(streaming.run()) << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
 
-    for (int i = 1; i < argc; i++) {
-        std::string arg = argv[i];
-        if (arg == "--csv" && i + 1 < argc) {
-            outputDirName = argv[++i];
-            output = OutputFormat::CsvFile;
+    // Lazy merged view: plain iteration against for_each_block, 10^4 to 10^6 merged with 10^7,
+    // and 1:1 inputs where the runs are short.
+    if (runViews) {
+        MergeViewBenchmark views;
+        views.addShape({10000, 10000000, CornerCaseType::RANDOM});
+        views.addShape({100000, 10000000, CornerCaseType::RANDOM});
+        views.addShape({1000000, 10000000, CornerCaseType::RANDOM});
+        views.addShape({1000000, 1000000, CornerCaseType::RANDOM});
+        views.addShape({1000000, 1000000, CornerCaseType::BLOCK_INTERLEAVE_A_B, 1000, 1000});
+        views.addShape({100000, 100000, CornerCaseType::DUPLICATES_IN_BOTH});
+        std::cout << views.generateReport(views.run()) << std::endl;
+        return 0;
+    }
+
+    // External-memory merge of on-disk runs generated in the given directory.
+    if (!externalDirName.empty()) {
+        if (!std::filesystem::exists(externalDirName)) {
+            std::cerr << "Error: directory doesn't exist " << externalDirName << std::endl;
+            return 1;
         }
+        ExternalMergeBenchmark external(externalDirName);
+        external.addShape({{100000, 10000000}, 16});
+        external.addShape({{1000000, 10000000}, 16});
+        external.addShape({{10000000, 10000000}, 16});
+        external.addShape({{2500000, 2500000, 2500000, 2500000}, 16});
+        external.addShape({{1000000, 10000000}, 16, 100000});
+        external.addShape({{10000000, 10000000}, 16, 100000});
+        external.addShape({{2500000, 2500000, 2500000, 2500000}, 16, 100000});
+        std::cout << external.generateReport(external.run()) << std::endl;
+        return 0;
     }
 
-    if (output == OutputFormat::CsvFile) {
+    // Sorted run files written, read back, merged and streamed in the given directory;
+    // file blocks of 3 elements exercise many block boundaries.
+    if (!runFileDirName.empty()) {
+        if (!std::filesystem::exists(runFileDirName)) {
+            std::cerr << "Error: directory doesn't exist " << runFileDirName << std::endl;
+            return 1;
+        }
+        RunFileBenchmark runFiles(runFileDirName);
+        runFiles.addShape({1000, 100000, CornerCaseType::RANDOM, 3});
+        runFiles.addShape({1000, 100000, CornerCaseType::RANDOM, 4096});
+        runFiles.addShape({100000, 100000, CornerCaseType::BLOCK_INTERLEAVE_A_B, 64, 1000, 1000});
+        runFiles.addShape({100000, 100000, CornerCaseType::BLOCK_INTERLEAVE_B_A, 4096, 20000, 20000});
+        runFiles.addShape({10000, 10000, CornerCaseType::DUPLICATES_IN_BOTH, 3});
+        runFiles.addShape({0, 10000, CornerCaseType::ONE_ARRAY_EMPTY, 64});
+        runFiles.addShape({10000, 10000, CornerCaseType::FIRST_ALL_SMALLER, 64});
+        try {
+            std::cout << runFiles.generateReport(runFiles.run()) << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!outputDirName.empty()) {
         if (!std::filesystem::exists(outputDirName)) {
             std::cerr << "Error: directory doesn't exist " << outputDirName << std::endl;
             return 1;
@@ -42,83 +479,95 @@ int main(int argc, char* argv[]) {
 
     AlgorithmTester tester;
 
-    // ====================================================================
-    // TEST CASES: Comprehensive evaluation of merge algorithms across a wide range of array sizes
-    // Array sizes range from 10^2 to 10^5 for both dimensions
-    // This provides a thorough assessment of algorithm performance across different scale factors
-    // ====================================================================
-
-    // Fixed first array (M=10^2) with varying second array (N) sizes from 10^2 to 10^5
-    tester.addScenario({100, 100, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=10^2
-    tester.addScenario({100, 500, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=5×10^2
-    tester.addScenario({100, 1000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=10^3
-    tester.addScenario({100, 5000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=5×10^3
-    tester.addScenario({100, 10000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=10^4
-    tester.addScenario({100, 50000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=5×10^4
-    tester.addScenario({100, 100000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});  // N=10^5
-
-    // Fixed first array (M=1000, 10^3) with varying second array (N) sizes from 10^2 to 10^5
-    tester.addScenario({1000, 100, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=10^2
-    tester.addScenario({1000, 500, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=5×10^2
-    tester.addScenario({1000, 1000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=10^3
-    tester.addScenario({1000, 5000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=5×10^3
-    tester.addScenario({1000, 10000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=10^4
-    tester.addScenario({1000, 50000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=5×10^4
-    tester.addScenario({1000, 100000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});  // N=10^5
-
-    // Fixed first array (M=10000, 10^4) with varying second array (N) sizes from 10^2 to 10^5
-    tester.addScenario({10000, 100, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=10^2
-    tester.addScenario({10000, 500, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=5×10^2
-    tester.addScenario({10000, 1000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=10^3
-    tester.addScenario({10000, 5000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=5×10^3
-    tester.addScenario({10000, 10000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=10^4
-    tester.addScenario({10000, 50000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=5×10^4
-    tester.addScenario({10000, 100000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});  // N=10^5
-
-    // Fixed first array (M=100000, 10^5) with varying second array (N) sizes from 10^2 to 10^5
-    tester.addScenario({100000, 100, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=10^2
-    tester.addScenario({100000, 500, CornerCaseType::RANDOM, 0, 1000000, 5, 5});     // N=5×10^2
-    tester.addScenario({100000, 1000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=10^3
-    tester.addScenario({100000, 5000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});    // N=5×10^3
-    tester.addScenario({100000, 10000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=10^4
-    tester.addScenario({100000, 50000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});   // N=5×10^4
-    tester.addScenario({100000, 100000, CornerCaseType::RANDOM, 0, 1000000, 5, 5});  // N=10^5
-
-    std::vector<std::unique_ptr<MergeAlgorithm>> algorithms;
-    algorithms.push_back(std::make_unique<TwoWayMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinDynamicMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinDynamicStableMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinKnuthMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinStaticMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinStaticKutznerMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<HwangLinStaticStableMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<FractialInsertionMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<SimpleKimKutznerMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<SplitMergeAlgorithm>());
-    algorithms.push_back(std::make_unique<UnstableCoreKimKutznerMergeAlgorithm>());
-
-    const std::string separator(REPORT_WIDTH, '=');
+    tester.setTiming(timing);
+    tester.setVerbose(output == OutputFormat::Console);
 
-    // Iterate over each algorithm and run the tests.
-    for (auto& alg : algorithms) {
-        std::cout << separator << std::endl;
-        std::cout << "Testing algorithm: " << alg->getName() << std::endl;
-        std::cout << separator << std::endl;
-
-        auto results = tester.runTests(*alg);
-        std::string report = tester.generateReport(results);
-        std::cout << report << std::endl;
+    try {
+        if (runLowCardinality) {
+            // Low-cardinality inputs (status codes, telemetry levels): 2, 16 and 256 distinct
+            // keys, run like the grid (timed on --key-type keys, counted on CountingInt).
+            for (int keys : {2, 16, 256}) {
+                tester.addScenario({10000, 10000, CornerCaseType::LOW_CARDINALITY, 0, 1000000, 5, 5, keys});
+                tester.addScenario({100000, 100000, CornerCaseType::LOW_CARDINALITY, 0, 1000000, 5, 5, keys});
+                tester.addScenario({1000, 100000, CornerCaseType::LOW_CARDINALITY, 0, 1000000, 5, 5, keys});
+            }
+        } else if (!scenarioFileName.empty()) {
+            for (const auto& scenario : loadScenarioFile(scenarioFileName)) {
+                tester.addScenario(scenario);
+            }
+        } else {
+            // ====================================================================
+            // TEST CASES: Comprehensive evaluation of merge algorithms across a wide range of array sizes
+            // Array sizes range from 10^2 to 10^5 for both dimensions
+            // This provides a thorough assessment of algorithm performance across different scale factors
+            // ====================================================================
 
-        if (output == OutputFormat::CsvFile) {
-            std::string filePath = outputDirName;
-            if (filePath.back() != '/' && filePath.back() != '\\') {
-                filePath += '/';
+            // Fixed first array M in {10^2, 10^3, 10^4, 10^5}, each with the second array N
+            // in {1, 5} x 10^2 .. 10^5; --m, --n and --cases replace any of the three.
+            std::vector<int> defaultSizesA = {100, 1000, 10000, 100000};
+            std::vector<int> defaultSizesB = {100, 500, 1000, 5000, 10000, 50000, 100000};
+            for (const auto& scenario : makeGridScenarios(
+                     sizesA.empty() ? defaultSizesA : parseSizes(sizesA),
+                     sizesB.empty() ? defaultSizesB : parseSizes(sizesB),
+                     caseList.empty() ? std::vector<CornerCaseType>{CornerCaseType::RANDOM} : parseCornerCases(caseList),
+                     scenarioDefaults)) {
+                tester.addScenario(scenario);
             }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
 
-            filePath += alg->getName() + ".csv";
+    // Dump every scenario as sorted run files instead of running the algorithms.
+    if (!dumpDirName.empty()) {
+        if (!std::filesystem::exists(dumpDirName)) {
+            std::cerr << "Error: directory doesn't exist " << dumpDirName << std::endl;
+            return 1;
+        }
+        for (const auto& scenario : tester.getScenarios()) {
+            MergeTestCase test_case = generateTestCase(scenario, 0);
+            std::string name = caseName(scenario);
+            std::replace(name.begin(), name.end(), ' ', '_');
+            std::string prefix = (std::filesystem::path(dumpDirName) /
+                (std::to_string(scenario.sizeA) + "_" + std::to_string(scenario.sizeB) + "_" + name)).string();
+            dump_merge_test_case(test_case, prefix);
+            std::cout << "Dumped " << prefix << "_{a,b,result}.run" << std::endl;
+        }
+        return 0;
+    }
 
-            tester.generateCSV(filePath, { results });
+    std::unique_ptr<DatasetCache> datasetCache;
+    if (!datasetCacheDirName.empty() || datasetCacheTmpfs) {
+        try {
+            datasetCache = std::make_unique<DatasetCache>(
+                datasetCacheDirName.empty() ? DatasetCache::tmpfsDirectory : datasetCacheDirName,
+                datasetsPerScenario, datasetMemoryMiB << 20, datasetCacheTmpfs);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
         }
+        tester.setDatasetCache(datasetCache.get());
+    }
+
+    // The test data can fail while running (e.g. a full cache directory).
+    try {
+        switch (keyType) {
+            case KeyType::Int32:    runAlgorithms<std::int32_t>(tester, algorithmFilter, output, outputDirName); break;
+            case KeyType::Int64:    runAlgorithms<std::int64_t>(tester, algorithmFilter, output, outputDirName); break;
+            case KeyType::Double:   runAlgorithms<double>(tester, algorithmFilter, output, outputDirName); break;
+            case KeyType::Counting: runAlgorithms<CountingInt>(tester, algorithmFilter, output, outputDirName); break;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (datasetCache && output == OutputFormat::Console) {
+        std::cout << "Dataset cache " << datasetCache->getDirectory() << ": "
+                  << datasetCache->getGenerated() << " generated, "
+                  << datasetCache->getMapped() << " mapped, "
+                  << datasetCache->getShared() << " shared from memory" << std::endl;
     }
 
     return 0;